@@ -0,0 +1,107 @@
+#include "Benchmarks.h"
+#include "../Pointers/allocators.h"
+#include "../Pointers/pointers.h"
+
+#include <cstdio>
+#include <memory_resource>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define ALLOCBENCH_FORK 1
+#endif
+
+namespace benchmarks {
+
+namespace {
+
+struct Sample {
+    double seconds;
+    size_t rssGrowth;    // RSS with every object alive minus RSS at start
+    size_t allocations;  // Global operator new calls
+};
+
+// Creates `count` unique ints and shared strings (longer than SSO), keeps
+// them all alive, then drops them: the ptrdemo factories at scale.
+template <typename MakeInt, typename MakeString>
+Sample runWorkload(size_t count, MakeInt&& makeInt, MakeString&& makeString) {
+    size_t rssBefore = currentRssBytes();
+    size_t allocsBefore = allocationCount();
+    size_t rssAlive = 0;
+    const std::string text(48, 'p');
+
+    double seconds = timeSeconds([&] {
+        std::vector<decltype(makeInt())> ints;
+        std::vector<decltype(makeString(text))> strings;
+        ints.reserve(count);
+        strings.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            ints.push_back(makeInt());
+            strings.push_back(makeString(text));
+        }
+        rssAlive = currentRssBytes();
+    });
+    return Sample{seconds, rssAlive > rssBefore ? rssAlive - rssBefore : 0, allocationCount() - allocsBefore};
+}
+
+// Runs one workload in a child process so each starts from a clean heap and
+// RSS growth is not hidden by memory the previous run left in malloc
+template <typename Run>
+Sample isolated(Run&& run) {
+#ifdef ALLOCBENCH_FORK
+    int fds[2];
+    if (pipe(fds) == 0) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            Sample sample = run();
+            ssize_t written = write(fds[1], &sample, sizeof(sample));
+            _exit(written == sizeof(sample) ? 0 : 1);
+        }
+        close(fds[1]);
+        Sample sample{};
+        ssize_t got = pid > 0 ? read(fds[0], &sample, sizeof(sample)) : -1;
+        close(fds[0]);
+        if (pid > 0) waitpid(pid, nullptr, 0);
+        if (got == sizeof(sample)) return sample;
+    }
+#endif
+    return run();
+}
+
+void report(const char* method, size_t count, const Sample& s) {
+    printf("  %-16s %8.1f ns/object pair  RSS +%10s  %6.2f global news/pair\n", method,
+           s.seconds * 1e9 / static_cast<double>(count), formatSize(s.rssGrowth).c_str(),
+           static_cast<double>(s.allocations) / static_cast<double>(count));
+}
+
+} // namespace
+
+void runAllocatorBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.empty() ? 1000000 : std::stoul(args[0]);
+
+    std::cout << "=== ALLOCATOR BENCHMARK ===\n";
+    std::cout << count << " x (makeSafeInt + makeSharedString), all alive then freed\n";
+
+    report("malloc (new)", count, isolated([&] {
+        return runWorkload(count,
+            [] { return ptrdemo::makeSafeInt(); },
+            [](const std::string& s) { return ptrdemo::makeSharedString(s); });
+    }));
+
+    report("FixedBlockPool", count, isolated([&] {
+        ptrdemo::FixedBlockPool pool(64, 4096);
+        return runWorkload(count,
+            [&] { return ptrdemo::makeSafeInt(pool); },
+            [&](const std::string& s) { return ptrdemo::makeSharedString(s, pool); });
+    }));
+
+    report("MonotonicArena", count, isolated([&] {
+        ptrdemo::MonotonicArena arena;
+        return runWorkload(count,
+            [&] { return ptrdemo::makeSafeInt(arena); },
+            [&](const std::string& s) { return ptrdemo::makeSharedString(s, arena); });
+    }));
+}
+
+} // namespace benchmarks
@@ -0,0 +1,128 @@
+#include "Benchmarks.h"
+#include "../Files/FileReader.h"
+#include "../Files/IoLoop.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace benchmarks {
+
+namespace {
+
+constexpr size_t kThreadGroup = 256;       // Threads alive at once in the thread-per-file variant
+constexpr size_t kAsyncChunk = 16 * 1024;  // Per-file buffer: thousands of files stay in a few tens of MB
+
+// Drops the files' pages from the page cache (clean pages need no root)
+void evict(const std::vector<std::string>& paths) {
+#if defined(__linux__)
+    for (const std::string& path : paths) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    (void)paths;
+#endif
+}
+
+size_t serialLines(const std::vector<std::string>& paths) {
+    size_t lines = 0;
+    for (const std::string& path : paths) FileReader(path).forEachLine([&](string_view) { ++lines; });
+    return lines;
+}
+
+// One blocking reader thread per file, kThreadGroup at a time
+size_t threadPerFileLines(const std::vector<std::string>& paths) {
+    std::vector<size_t> counts(paths.size());
+    for (size_t begin = 0; begin < paths.size(); begin += kThreadGroup) {
+        std::vector<std::thread> threads;
+        for (size_t i = begin; i < std::min(paths.size(), begin + kThreadGroup); ++i) {
+            threads.emplace_back([&, i] { FileReader(paths[i]).forEachLine([&](string_view) { ++counts[i]; }); });
+        }
+        for (std::thread& thread : threads) thread.join();
+    }
+    size_t lines = 0;
+    for (size_t count : counts) lines += count;
+    return lines;
+}
+
+Task countLines(AsyncGenerator<string_view> lines, size_t& count) {
+    while (optional<string_view> line = co_await lines.next()) ++count;
+}
+
+// Every file in flight on the calling thread
+size_t loopLines(const std::vector<std::string>& paths, IoLoop::Backend backend, IoLoop::Stats& stats) {
+    IoLoop loop({backend, 256});
+    size_t lines = 0;
+    for (const std::string& path : paths) {
+        loop.spawn(countLines(FileReader(path).readLinesAsync(loop, kAsyncChunk), lines));
+    }
+    loop.run();
+    stats = loop.stats();
+    return lines;
+}
+
+void report(const char* method, size_t files, uint64_t bytes, double seconds, bool ok) {
+    printf("  %-28s %10.0f files/s %8.1f MB/s%s\n", method, static_cast<double>(files) / seconds,
+           static_cast<double>(bytes) / (1 << 20) / seconds, ok ? "" : "  MISMATCH");
+}
+
+} // namespace
+
+void runAsyncReadBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.size() > 0 ? std::stoul(args[0]) : 2000;
+    size_t fileSize = args.size() > 1 ? parseSize(args[1]) : 32 * 1024;
+    if (count == 0 || fileSize == 0) {
+        std::cerr << "Usage: bench async [files] [file size]\n";
+        return;
+    }
+
+    std::cout << "=== ASYNC READ BENCHMARK ===\n";
+    std::cout << "io_uring " << (IoLoop::ioUringSupported() ? "available" : "unavailable") << '\n';
+    auto root = std::filesystem::temp_directory_path() / "async_read_bench";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < count; ++i) {
+        paths.push_back((root / ("file" + std::to_string(i) + ".log")).string());
+        writeSampleFile(paths.back(), fileSize);
+    }
+    const uint64_t bytes = static_cast<uint64_t>(count) * fileSize;
+
+    for (bool cold : {false, true}) {
+        std::cout << count << " files of " << formatSize(fileSize) << ", "
+                  << (cold ? "cold cache (evicted before each run)" : "warm cache") << ":\n";
+        size_t expected = 0;
+        if (cold) evict(paths);
+        double seconds = timeSeconds([&] { expected = serialLines(paths); });
+        report("serial forEachLine", count, bytes, seconds, true);
+
+        size_t lines = 0;
+        if (cold) evict(paths);
+        seconds = timeSeconds([&] { lines = threadPerFileLines(paths); });
+        report("thread per file", count, bytes, seconds, lines == expected);
+
+        for (IoLoop::Backend backend : {IoLoop::Backend::IoUring, IoLoop::Backend::Inline}) {
+            IoLoop::Stats stats;
+            if (cold) evict(paths);
+            seconds = timeSeconds([&] { lines = loopLines(paths, backend, stats); });
+            std::string name = std::string("IoLoop ") + IoLoop::backendName(stats.backend) + ", 1 thread";
+            report(name.c_str(), count, bytes, seconds, lines == expected);
+            if (stats.waits > 0) {
+                printf("  %-28s %10.1f reads per io_uring_enter\n", "",
+                       static_cast<double>(stats.reads) / static_cast<double>(stats.waits));
+            }
+        }
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+} // namespace benchmarks
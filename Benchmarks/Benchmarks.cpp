@@ -0,0 +1,88 @@
+#include "Benchmarks.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace benchmarks {
+
+namespace {
+std::atomic<size_t> allocations{0};
+} // namespace
+
+size_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void noteAllocation() {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t currentRssBytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+size_t parseSize(const std::string& text) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    if (end == text.c_str()) return 0;
+    switch (*end) {
+        case '\0': return value;
+        case 'K': case 'k': return value << 10;
+        case 'M': case 'm': return value << 20;
+        case 'G': case 'g': return value << 30;
+        default: return 0;
+    }
+}
+
+std::string formatSize(size_t bytes) {
+    static const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        ++unit;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f %s", value, units[unit]);
+    return buffer;
+}
+
+void writeSampleFile(const std::filesystem::path& path, size_t bytes) {
+    std::ofstream out(path, std::ios::binary);
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> lineLength(20, 180);
+    std::string line;
+    size_t written = 0;
+    while (written < bytes) {
+        line.assign(static_cast<size_t>(lineLength(rng)), static_cast<char>('a' + written % 26));
+        line += '\n';
+        if (written + line.size() > bytes) line.resize(bytes - written);
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        written += line.size();
+    }
+}
+
+} // namespace benchmarks
@@ -0,0 +1,128 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Benchmark suites for the demo modules. Each suite takes the remaining
+// command-line arguments of the bench driver (see bench.cpp).
+namespace benchmarks {
+
+// Wall-clock seconds taken by one call of f
+template <typename F>
+double timeSeconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    std::forward<F>(f)();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Heap allocations made so far. Only the bench executable counts them
+// (bench.cpp replaces global operator new); elsewhere this stays 0.
+size_t allocationCount();
+void noteAllocation();
+
+// Resident set size of this process in bytes (0 where unsupported)
+size_t currentRssBytes();
+
+// Parses sizes like "4096", "64K", "1M", "10G"; returns 0 on bad input
+size_t parseSize(const std::string& text);
+
+// Human-readable byte count ("1.0 MB")
+std::string formatSize(size_t bytes);
+
+// Writes `bytes` of log-like text with lines of 20..180 characters; the
+// same inputs feed every file-reading suite
+void writeSampleFile(const std::filesystem::path& path, size_t bytes);
+
+// Discards everything written to it, so the demo readers' cout output
+// costs the stream machinery but no terminal I/O.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+// FileReader: old style vs modern style vs zero-copy, 1 MB .. 10 GB
+void runFileReaderBenchmarks(const std::vector<std::string>& args);
+
+// LineScanner: per-ISA newline kernels vs getline, with a differential check
+void runLineScannerBenchmarks(const std::vector<std::string>& args);
+
+// ParallelFileReader: scaling from 1 to N threads against the serial reader
+void runParallelReaderBenchmarks(const std::vector<std::string>& args);
+
+// FilenameValidator: batch validation vs FormatDemo::isValidFilename
+void runFilenameValidatorBenchmarks(const std::vector<std::string>& args);
+
+// Sanitizer: sanitizeInput vs the allocation-free variants, allocations per call
+void runSanitizerBenchmarks(const std::vector<std::string>& args);
+
+// SafeFormat: formatTo/formatFixed vs printf, ostream, stringstream, snprintf, std::format
+void runFormatBenchmarks(const std::vector<std::string>& args);
+
+// AsyncLogger: producer latency histograms vs per-line flushed streams
+void runLoggerBenchmarks(const std::vector<std::string>& args);
+
+// safe_math checked/saturating integers vs unchecked arithmetic
+void runCheckedArithmeticBenchmarks(const std::vector<std::string>& args);
+
+// safe_math::reduce: per-ISA sum/min/max with overflow detection
+void runSpanReduceBenchmarks(const std::vector<std::string>& args);
+
+// ptrdemo allocators: malloc vs FixedBlockPool vs MonotonicArena, time and RSS
+void runAllocatorBenchmarks(const std::vector<std::string>& args);
+
+// SharedString vs shared_ptr<string>: copy/access/destroy, 1 and N threads
+void runSharedStringBenchmarks(const std::vector<std::string>& args);
+
+// CheckedSpan/SmallVector vs raw arrays, vector::operator[] and vector::at
+void runCheckedSpanBenchmarks(const std::vector<std::string>& args);
+
+// radixSort/ParallelSorter vs std::sort by size, distribution and threads; kWayMerge
+void runSortBenchmarks(const std::vector<std::string>& args);
+
+// SecurePipeline vs the serial getline loop; throughput, stage/queue counters, RSS
+void runPipelineBenchmarks(const std::vector<std::string>& args);
+
+// PatternScanner: one-pass multi-pattern line flagging vs repeated find()
+void runPatternScannerBenchmarks(const std::vector<std::string>& args);
+
+// gzip / zstd input through FileReader vs plain text, end to end
+void runCompressedBenchmarks(const std::vector<std::string>& args);
+
+// FileFollower: incremental reads after appends vs full rescans, idle CPU
+void runFollowBenchmarks(const std::vector<std::string>& args);
+
+// DirectoryIngest (io_uring / thread pool) vs the one-file-at-a-time loop, files/s
+void runIngestBenchmarks(const std::vector<std::string>& args);
+
+// ValidationCache: Zipf-distributed repeats vs uncached validate + sanitize, 1 and N threads
+void runValidationCacheBenchmarks(const std::vector<std::string>& args);
+
+// FileReader async generators on an IoLoop vs serial and thread-per-file reads
+void runAsyncReadBenchmarks(const std::vector<std::string>& args);
+
+// LineIndex: random line seeks vs getline scans, full and incremental builds
+void runLineIndexBenchmarks(const std::vector<std::string>& args);
+
+// Regression set on the Harness: FileReader, FormatDemo validation and
+// sanitizing, ptrdemo containers; percentiles, allocations, optional JSON
+void runRegressionBenchmarks(const std::vector<std::string>& args);
+
+} // namespace benchmarks
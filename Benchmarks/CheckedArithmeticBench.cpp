@@ -0,0 +1,71 @@
+#include "Benchmarks.h"
+#include "../overandunderflow/CheckedArithmetic.h"
+
+#include <cstdio>
+#include <random>
+
+namespace benchmarks {
+
+namespace {
+
+void report(const char* method, size_t elements, double seconds, double baseline) {
+    printf("  %-30s %8.3f ns/elem  %6.2fx unchecked\n", method,
+           seconds * 1e9 / static_cast<double>(elements), seconds / baseline);
+}
+
+} // namespace
+
+void runCheckedArithmeticBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.empty() ? (1u << 24) : std::stoul(args[0]);
+
+    std::cout << "=== CHECKED ARITHMETIC BENCHMARK ===\n";
+    std::mt19937 rng(3);
+    // Small values: overflow never happens, so this measures pure overhead
+    std::uniform_int_distribution<int> dist(-1000, 1000);
+    std::vector<int> a(count), b(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+    }
+    std::span<const int> sa(a), sb(b);
+
+    std::cout << "Element-wise add, " << count << " ints:\n";
+    double unchecked = timeSeconds([&] {
+        for (size_t i = 0; i < count; ++i) out[i] = a[i] + b[i];
+    });
+    doNotOptimize(out[count / 2]);
+    report("unchecked a[i] + b[i]", count, unchecked, unchecked);
+    report("batch add<SaturatePolicy>", count, timeSeconds([&] { safe_math::add<safe_math::SaturatePolicy>(sa, sb, std::span<int>(out)); }), unchecked);
+    report("batch add<FlagPolicy>", count, timeSeconds([&] { safe_math::add<safe_math::FlagPolicy>(sa, sb, std::span<int>(out)); }), unchecked);
+    report("batch add<ThrowPolicy>", count, timeSeconds([&] { safe_math::add<safe_math::ThrowPolicy>(sa, sb, std::span<int>(out)); }), unchecked);
+    report("batch mul<SaturatePolicy>", count, timeSeconds([&] { safe_math::mul<safe_math::SaturatePolicy>(sa, sb, std::span<int>(out)); }), unchecked);
+    report("loop of checked<int> +", count, timeSeconds([&] {
+        for (size_t i = 0; i < count; ++i) out[i] = (safe_math::checked<int>(a[i]) + b[i]).value();
+    }), unchecked);
+    report("loop of saturating<int> +", count, timeSeconds([&] {
+        for (size_t i = 0; i < count; ++i) out[i] = (safe_math::saturating<int>(a[i]) + b[i]).value();
+    }), unchecked);
+    doNotOptimize(out[count / 3]);
+
+    std::cout << "Running sum (loop-carried), " << count << " ints:\n";
+    long long plain = 0;
+    double sumUnchecked = timeSeconds([&] {
+        int acc = 0;
+        for (int v : a) acc += v;
+        plain = acc;
+    });
+    doNotOptimize(plain);
+    report("int +=", count, sumUnchecked, sumUnchecked);
+    report("checked<int> +=", count, timeSeconds([&] {
+        safe_math::checked<int> acc = 0;
+        for (int v : a) acc += v;
+        doNotOptimize(acc);
+    }), sumUnchecked);
+    report("saturating<int> +=", count, timeSeconds([&] {
+        safe_math::saturating<int> acc = 0;
+        for (int v : a) acc += v;
+        doNotOptimize(acc);
+    }), sumUnchecked);
+}
+
+} // namespace benchmarks
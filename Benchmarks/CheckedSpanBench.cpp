@@ -0,0 +1,103 @@
+#include "Benchmarks.h"
+#include "../Pointers/pointers.h"
+
+#include <cstdio>
+#include <memory>
+#include <numeric>
+
+namespace benchmarks {
+
+using ptrdemo::CheckedSpan;
+using ptrdemo::SmallVector;
+
+namespace {
+
+// Sum through at(i) for every index; any per-access check stays in the loop
+template <typename Access>
+double indexedSum(size_t n, size_t passes, Access&& at) {
+    long long total = 0;
+    double seconds = timeSeconds([&] {
+        for (size_t p = 0; p < passes; ++p) {
+            for (size_t i = 0; i < n; ++i) total += at(i);
+        }
+    });
+    doNotOptimize(total);
+    return seconds;
+}
+
+template <typename Range>
+double rangeSum(const Range& range, size_t passes) {
+    long long total = 0;
+    double seconds = timeSeconds([&] {
+        for (size_t p = 0; p < passes; ++p) {
+            for (int x : range) total += x;
+            doNotOptimize(total);
+        }
+    });
+    doNotOptimize(total);
+    return seconds;
+}
+
+// Builds and drops `count` small arrays of `elements` ints
+template <typename Vec>
+double buildSmall(size_t count, int elements) {
+    long long total = 0;
+    double seconds = timeSeconds([&] {
+        for (size_t c = 0; c < count; ++c) {
+            Vec v;
+            for (int i = 0; i < elements; ++i) v.push_back(i);
+            total += v[static_cast<size_t>(elements - 1)];
+            doNotOptimize(v);
+        }
+    });
+    doNotOptimize(total);
+    return seconds;
+}
+
+void report(const char* method, size_t ops, double seconds, size_t allocs = 0) {
+    printf("  %-30s %8.3f ns/element  %10zu allocs\n", method,
+           seconds * 1e9 / static_cast<double>(ops), allocs);
+}
+
+} // namespace
+
+void runCheckedSpanBenchmarks(const std::vector<std::string>& args) {
+    size_t n = args.size() > 0 ? parseSize(args[0]) : 4096;
+    if (n == 0) n = 4096;
+    size_t passes = std::max<size_t>(1, (size_t{256} << 20) / n);
+
+    std::cout << "=== CHECKED SPAN BENCHMARK ===\n"
+              << "Bounds checks " << (PTRDEMO_BOUNDS_CHECK ? "ON" : "OFF")
+              << " in this build; " << n << " ints x " << passes << " passes\n";
+
+    std::vector<int> v(n);
+    std::iota(v.begin(), v.end(), 0);
+    std::unique_ptr<int[]> raw(new int[n]);
+    std::copy(v.begin(), v.end(), raw.get());
+    CheckedSpan<const int> span(v);
+    size_t ops = n * passes;
+
+    std::cout << "Indexed loop:\n";
+    report("raw array", ops, indexedSum(n, passes, [&](size_t i) { return raw[i]; }));
+    report("vector operator[]", ops, indexedSum(n, passes, [&](size_t i) { return v[i]; }));
+    report("vector::at", ops, indexedSum(n, passes, [&](size_t i) { return v.at(i); }));
+    report("CheckedSpan operator[]", ops, indexedSum(n, passes, [&](size_t i) { return span[i]; }));
+
+    std::cout << "Range-for loop:\n";
+    report("vector", ops, rangeSum(v, passes));
+    report("CheckedSpan", ops, rangeSum(span, passes));
+
+    size_t count = 1000000;
+    for (int elements : {4, 16, 64}) {
+        std::cout << "Build + drop " << count << " arrays of " << elements << " ints:\n";
+        size_t ops2 = count * static_cast<size_t>(elements);
+        size_t before = allocationCount();
+        double seconds = buildSmall<std::vector<int>>(count, elements);
+        report("std::vector<int>", ops2, seconds, allocationCount() - before);
+        before = allocationCount();
+        seconds = buildSmall<SmallVector<int, 16>>(count, elements);
+        report("SmallVector<int, 16>", ops2, seconds, allocationCount() - before);
+    }
+}
+
+} // namespace benchmarks
@@ -0,0 +1,82 @@
+#include "Benchmarks.h"
+#include "../Files/FileReader.h"
+#include "../Files/MappedFile.h"
+#include "../Files/StreamDecompressor.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace benchmarks {
+
+namespace {
+
+// Per-line work standing in for real processing: FNV-1a over the bytes
+uint64_t hashLines(FileReader& reader, size_t& lines) {
+    uint64_t hash = 14695981039346656037ull;
+    lines = 0;
+    reader.forEachLine([&](std::string_view line) {
+        for (char c : line) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        ++lines;
+    });
+    return hash;
+}
+
+} // namespace
+
+void runCompressedBenchmarks(const std::vector<std::string>& args) {
+    size_t size = args.empty() ? 64 * 1024 * 1024 : parseSize(args[0]);
+
+    std::cout << "=== COMPRESSED INPUT BENCHMARK ===\n";
+    auto dir = std::filesystem::temp_directory_path();
+    auto plain = dir / "compressed_bench.log";
+    writeSampleFile(plain, size);
+    const double mb = static_cast<double>(size) / (1 << 20);
+
+    FileReader plainReader(plain.string());
+    size_t plainLines = 0;
+    uint64_t plainHash = 0;
+    double plainSeconds = timeSeconds([&] { plainHash = hashLines(plainReader, plainLines); });
+    printf("%s of text, %zu lines\n", formatSize(size).c_str(), plainLines);
+    printf("  %-6s %-28s %8.1f MB/s\n", "plain", "lines + hash", mb / plainSeconds);
+
+    struct Codec {
+        Compression format;
+        const char* extension;
+        const char* command;
+    };
+    for (Codec codec : {Codec{Compression::Gzip, ".gz", "gzip -6 -c"}, Codec{Compression::Zstd, ".zst", "zstd -3 -q -c"}}) {
+        const char* name = StreamDecompressor::name(codec.format);
+        if (!StreamDecompressor::supported(codec.format)) {
+            printf("  %-6s not supported by this build\n", name);
+            continue;
+        }
+        auto compressed = dir / ("compressed_bench.log" + std::string(codec.extension));
+        std::string command = std::string(codec.command) + " '" + plain.string() + "' > '" + compressed.string() + "'";
+        if (std::system(command.c_str()) != 0) {
+            printf("  %-6s skipped (%s failed)\n", name, codec.command);
+            continue;
+        }
+
+        // Decompression alone, then decompression overlapped with the line work
+        MappedFile mapped(compressed.string());
+        double inflateSeconds = timeSeconds([&] {
+            StreamDecompressor().decompress(mapped.view(), codec.format, [](std::string_view chunk) { doNotOptimize(chunk); });
+        });
+        FileReader reader(compressed.string());
+        size_t lines = 0;
+        uint64_t hash = 0;
+        double endToEnd = timeSeconds([&] { hash = hashLines(reader, lines); });
+
+        printf("  %-6s ratio %.2f, decompress only %8.1f MB/s\n", name,
+               static_cast<double>(size) / static_cast<double>(mapped.size()), mb / inflateSeconds);
+        printf("  %-6s %-28s %8.1f MB/s  (serial sum would be %.1f MB/s)%s\n", name, "lines + hash, end to end",
+               mb / endToEnd, mb / (inflateSeconds + plainSeconds),
+               lines == plainLines && hash == plainHash ? "" : "  MISMATCH");
+        std::filesystem::remove(compressed);
+    }
+
+    std::filesystem::remove(plain);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,63 @@
+#include "Benchmarks.h"
+#include "../Files/FileReader.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace benchmarks {
+
+namespace {
+
+void report(const char* method, size_t bytes, double seconds) {
+    double mbPerSec = static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds;
+    printf("  %-22s %10.3f s  %10.1f MB/s\n", method, seconds, mbPerSec);
+}
+
+} // namespace
+
+void runFileReaderBenchmarks(const std::vector<std::string>& args) {
+    // 10G is opt-in: it needs that much free space in the temp directory
+    std::vector<size_t> sizes;
+    for (const auto& arg : args) {
+        if (size_t size = parseSize(arg)) sizes.push_back(size);
+    }
+    if (sizes.empty()) sizes = {1u << 20, 16u << 20, 256u << 20};
+
+    std::cout << "=== FILEREADER BENCHMARK ===\n";
+    auto path = std::filesystem::temp_directory_path() / "filereader_bench.txt";
+
+    for (size_t size : sizes) {
+        writeSampleFile(path, size);
+        std::cout << "File size " << formatSize(size) << ":\n";
+        FileReader reader(path.string());
+
+        NullBuffer null;
+        std::streambuf* saved = std::cout.rdbuf(&null);
+        double oldStyle = timeSeconds([&] { reader.readFileOldStyle(); });
+        double modernStyle = timeSeconds([&] { reader.readFileModernStyle(); });
+        double zeroCopy = timeSeconds([&] {
+            reader.forEachLine([](std::string_view line) { std::cout << line << '\n'; });
+        });
+        std::cout.rdbuf(saved);
+
+        size_t lines = 0, chars = 0;
+        double countOnly = timeSeconds([&] {
+            reader.forEachLine([&](std::string_view line) {
+                ++lines;
+                chars += line.size();
+            });
+        });
+        doNotOptimize(chars);
+
+        report("readFileOldStyle", size, oldStyle);
+        report("readFileModernStyle", size, modernStyle);
+        report("forEachLine (cout)", size, zeroCopy);
+        report("forEachLine (count)", size, countOnly);
+        std::cout << "  (" << lines << " lines)\n";
+    }
+
+    std::filesystem::remove(path);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,81 @@
+#include "Benchmarks.h"
+#include "../Format/FilenameValidator.h"
+#include "../Format/FormatSecurity.h"
+
+#include <cstdio>
+#include <random>
+
+namespace benchmarks {
+
+using format_security::FilenameBatch;
+using format_security::FilenameValidator;
+using format_security::FilenameVerdict;
+using format_security::FormatDemo;
+
+namespace {
+
+// Mostly ordinary paths with a sprinkling of every reject reason
+std::vector<std::string> makeFilenames(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> length(1, 80), kind(0, 99), byte(0, 255);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string name = "logs/app-" + std::to_string(i) + "/";
+        int extra = length(rng);
+        for (int k = 0; k < extra; ++k) name += static_cast<char>('a' + k % 26);
+        name += ".txt";
+        switch (kind(rng)) {
+            case 0: name = "../" + name; break;
+            case 1: name[name.size() / 2] = '\n'; break;
+            case 2: name += "%n"; break;
+            case 3: name.clear(); break;
+            case 4: name.append(300, 'x'); break;
+            case 5: name[name.size() / 3] = static_cast<char>(byte(rng)); break;
+            case 6: name += '.'; break;  // Trailing dot, next name may start with one
+            case 7: name = "." + name; break;
+            default: break;
+        }
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+} // namespace
+
+void runFilenameValidatorBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.empty() ? 1000000 : std::stoul(args[0]);
+
+    std::cout << "=== FILENAME VALIDATOR BENCHMARK ===\n";
+    auto names = makeFilenames(count, 7);
+    FilenameBatch batch;
+    for (const auto& name : names) batch.add(name);
+
+    // Differential check against the per-name function
+    auto verdicts = FilenameValidator::validate(batch);
+    size_t mismatches = 0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        bool batchValid = verdicts[i] == FilenameVerdict::Valid;
+        if (batchValid != FormatDemo::isValidFilename(names[i])) ++mismatches;
+    }
+    std::cout << "Differential check vs isValidFilename: "
+              << (mismatches ? "FAILED (" + std::to_string(mismatches) + ")" : std::string("ok")) << '\n';
+
+    size_t perNameValid = 0;
+    double perName = timeSeconds([&] {
+        for (const auto& name : names) perNameValid += FormatDemo::isValidFilename(name);
+    });
+    size_t batchValid = 0;
+    double batched = timeSeconds([&] {
+        batchValid = FilenameValidator::validate(batch.data.data(), batch.offsets.data(),
+                                                 batch.size(), verdicts.data());
+    });
+    doNotOptimize(perNameValid);
+
+    double mb = static_cast<double>(batch.data.size()) / (1 << 20);
+    printf("  %zu names, %s, %zu valid\n", names.size(), formatSize(batch.data.size()).c_str(), batchValid);
+    printf("  %-20s %10.1f M names/s %10.1f MB/s\n", "isValidFilename", count / perName / 1e6, mb / perName);
+    printf("  %-20s %10.1f M names/s %10.1f MB/s\n", "FilenameValidator", count / batched / 1e6, mb / batched);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,81 @@
+#include "Benchmarks.h"
+#include "../Files/FileFollower.h"
+#include "../Files/FileReader.h"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+namespace benchmarks {
+
+namespace {
+
+double cpuSeconds() { return static_cast<double>(std::clock()) / CLOCKS_PER_SEC; }
+
+void appendLines(const std::filesystem::path& path, size_t count, size_t& serial) {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    for (size_t i = 0; i < count; ++i) out << "2024-01-01T00:00:00Z INFO request " << serial++ << " served in 3ms\n";
+}
+
+} // namespace
+
+void runFollowBenchmarks(const std::vector<std::string>& args) {
+    size_t initial = args.empty() ? 32 * 1024 * 1024 : parseSize(args[0]);
+    const size_t updates = 50;
+    const size_t linesPerUpdate = 1000;
+
+    std::cout << "=== FILE FOLLOW BENCHMARK ===\n";
+    auto path = std::filesystem::temp_directory_path() / "follow_bench.log";
+    writeSampleFile(path, initial);
+
+    // Catching up after each append: full rescan vs incremental read
+    {
+        FileReader reader(path.string());
+        FileFollower follower(path.string(), FileFollower::Options{true});
+        size_t serial = 0;
+        double rescan = 0, incremental = 0;
+        size_t rescanLines = 0, newLines = 0;
+        for (size_t u = 0; u < updates; ++u) {
+            appendLines(path, linesPerUpdate, serial);
+            rescan += timeSeconds([&] { rescanLines = 0; reader.forEachLine([&](std::string_view) { ++rescanLines; }); });
+            incremental += timeSeconds([&] { newLines += follower.poll([](std::string_view line) { doNotOptimize(line); }); });
+        }
+        printf("%s log, %zu appends of %zu lines:\n", formatSize(initial).c_str(), updates, linesPerUpdate);
+        printf("  full rescan (forEachLine)  %10.1f us/update  (%zu lines scanned last time)\n",
+               rescan / updates * 1e6, rescanLines);
+        printf("  FileFollower::poll         %10.1f us/update  (%zu new lines seen, %s)\n",
+               incremental / updates * 1e6, newLines, newLines == updates * linesPerUpdate ? "ok" : "MISMATCH");
+    }
+
+    // Live follow: CPU while idle, then while a writer appends
+    {
+        FileFollower follower(path.string(), FileFollower::Options{true});
+        size_t seen = 0;
+        std::thread runner([&] { follower.run([&](std::string_view) { ++seen; }); });
+
+        double cpu = cpuSeconds();
+        double wall = timeSeconds([] { std::this_thread::sleep_for(std::chrono::seconds(1)); });
+        double idleCpu = cpuSeconds() - cpu;
+        size_t idleWakeups = follower.stats().wakeups;
+
+        size_t serial = 0;
+        const size_t bursts = 200;
+        for (size_t b = 0; b < bursts; ++b) {
+            appendLines(path, 50, serial);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        follower.stop();
+        runner.join();
+
+        printf("Live follow (%s):\n", follower.usingInotify() ? "inotify" : "polling");
+        printf("  idle %.2f s: %.2f ms CPU, %zu wakeups\n", wall, idleCpu * 1e3, idleWakeups);
+        printf("  %zu bursts of 50 lines: %zu lines seen (%s), %zu wakeups\n", bursts, seen,
+               seen == serial ? "ok" : "MISMATCH", follower.stats().wakeups - idleWakeups);
+    }
+
+    std::filesystem::remove(path);
+}
+
+} // namespace benchmarks
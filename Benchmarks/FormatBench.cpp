@@ -0,0 +1,80 @@
+#include "Benchmarks.h"
+#include "../Format/SafeFormat.h"
+
+#include <cstdio>
+#include <sstream>
+#include <version>
+#ifdef __cpp_lib_format
+#include <format>
+#endif
+
+namespace benchmarks {
+
+using format_security::formatFixed;
+using format_security::formatTo;
+
+// The message demonstrateSecureFormatting builds with each method
+void runFormatBenchmarks(const std::vector<std::string>& args) {
+    size_t iterations = args.empty() ? 1000000 : std::stoul(args[0]);
+
+    std::cout << "=== FORMAT BENCHMARK ===\n";
+    const std::string filename = "data.txt";
+    const int lineCount = 42;
+    const double fileSize = 1024.5;
+    size_t sink = 0;
+
+    auto measure = [&](const char* method, auto&& body) {
+        size_t before = allocationCount();
+        double seconds = timeSeconds([&] {
+            for (size_t i = 0; i < iterations; ++i) body();
+        });
+        printf("  %-22s %8.1f ns/call %8.2f allocs/call\n", method,
+               seconds * 1e9 / static_cast<double>(iterations),
+               static_cast<double>(allocationCount() - before) / static_cast<double>(iterations));
+    };
+
+    FILE* devnull = fopen("/dev/null", "w");
+    if (devnull) {
+        measure("printf (to /dev/null)", [&] {
+            fprintf(devnull, "File: %s, Lines: %d, Size: %.1f KB\n", filename.c_str(), lineCount, fileSize);
+        });
+    }
+
+    NullBuffer null;
+    std::ostream out(&null);
+    measure("ostream <<", [&] {
+        out << "File: " << filename << ", Lines: " << lineCount << ", Size: " << fileSize << " KB\n";
+    });
+
+    measure("stringstream", [&] {
+        std::stringstream ss;
+        ss << "File: " << filename << ", Lines: " << lineCount << ", Size: " << fileSize << " KB";
+        sink += ss.str().size();
+    });
+
+    measure("snprintf", [&] {
+        char buffer[256];
+        sink += static_cast<size_t>(snprintf(buffer, sizeof(buffer), "File: %s, Lines: %d, Size: %.1f KB",
+                                             filename.c_str(), lineCount, fileSize));
+    });
+
+#ifdef __cpp_lib_format
+    measure("std::format", [&] {
+        sink += std::format("File: {}, Lines: {}, Size: {:.1f} KB", filename, lineCount, fileSize).size();
+    });
+#endif
+
+    measure("formatTo (span)", [&] {
+        char buffer[256];
+        sink += formatTo(buffer, "File: {}, Lines: {}, Size: {:.1f} KB", filename, lineCount, fileSize);
+    });
+
+    measure("formatFixed<128>", [&] {
+        sink += formatFixed<128>("File: {}, Lines: {}, Size: {:.1f} KB", filename, lineCount, fileSize).size();
+    });
+
+    if (devnull) fclose(devnull);
+    doNotOptimize(sink);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,129 @@
+#include "Harness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+namespace benchmarks {
+
+namespace {
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+    }
+    return out;
+}
+
+// Per-item time with a readable unit
+std::string perItem(double seconds, size_t items) {
+    double ns = seconds * 1e9 / static_cast<double>(std::max<size_t>(items, 1));
+    char buf[32];
+    if (ns < 1e3) snprintf(buf, sizeof(buf), "%.2f ns", ns);
+    else if (ns < 1e6) snprintf(buf, sizeof(buf), "%.2f us", ns / 1e3);
+    else snprintf(buf, sizeof(buf), "%.2f ms", ns / 1e6);
+    return buf;
+}
+
+} // namespace
+
+HarnessOptions parseHarnessOptions(const std::vector<std::string>& args, std::vector<std::string>& rest) {
+    HarnessOptions options;
+    for (const auto& arg : args) {
+        if (arg.rfind("--warmup=", 0) == 0) {
+            options.warmup = std::stoul(arg.substr(9));
+        } else if (arg.rfind("--reps=", 0) == 0) {
+            options.repetitions = std::max<size_t>(1, std::stoul(arg.substr(7)));
+        } else if (arg.rfind("--json=", 0) == 0) {
+            options.jsonPath = arg.substr(7);
+        } else if (arg.rfind("--filter=", 0) == 0) {
+            options.filter = arg.substr(9);
+        } else {
+            rest.push_back(arg);
+        }
+    }
+    return options;
+}
+
+Harness::Harness(std::string suite, HarnessOptions options) : suite_(std::move(suite)), options_(std::move(options)) {
+    printf("%-40s %11s %11s %11s %11s %9s\n", "case (per item)", "median", "p90", "p99", "min", "allocs");
+}
+
+void Harness::record(const std::string& name, size_t items, std::vector<double> seconds, size_t allocations) {
+    Measurement m;
+    m.name = name;
+    m.items = items;
+    m.allocationsPerRun = static_cast<double>(allocations) / static_cast<double>(seconds.size());
+
+    std::vector<double> sorted = seconds;
+    std::sort(sorted.begin(), sorted.end());
+    m.min = sorted.front();
+    m.median = percentile(sorted, 50);
+    m.p90 = percentile(sorted, 90);
+    m.p99 = percentile(sorted, 99);
+    m.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    m.seconds = std::move(seconds);
+
+    printf("%-40s %11s %11s %11s %11s %9.2f\n", name.c_str(), perItem(m.median, items).c_str(),
+           perItem(m.p90, items).c_str(), perItem(m.p99, items).c_str(), perItem(m.min, items).c_str(),
+           m.allocationsPerRun / static_cast<double>(std::max<size_t>(items, 1)));
+    fflush(stdout);
+    results_.push_back(std::move(m));
+}
+
+std::string Harness::toJson() const {
+    std::string out = "{\n  \"suite\": \"" + jsonEscape(suite_) + "\",\n";
+    out += "  \"warmup\": " + std::to_string(options_.warmup) + ",\n";
+    out += "  \"repetitions\": " + std::to_string(options_.repetitions) + ",\n";
+    out += "  \"results\": [";
+    char buf[256];
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const Measurement& m = results_[i];
+        out += i ? ",\n" : "\n";
+        out += "    {\"name\": \"" + jsonEscape(m.name) + "\", ";
+        snprintf(buf, sizeof(buf),
+                 "\"items\": %zu, \"min_ns\": %.1f, \"median_ns\": %.1f, \"p90_ns\": %.1f, "
+                 "\"p99_ns\": %.1f, \"mean_ns\": %.1f, \"allocations_per_run\": %.2f}",
+                 m.items, m.min * 1e9, m.median * 1e9, m.p90 * 1e9, m.p99 * 1e9, m.mean * 1e9,
+                 m.allocationsPerRun);
+        out += buf;
+    }
+    out += "\n  ]\n}\n";
+    return out;
+}
+
+bool Harness::finish() const {
+    if (options_.jsonPath.empty()) return true;
+    std::ofstream file(options_.jsonPath, std::ios::binary | std::ios::trunc);
+    file << toJson();
+    if (!file) {
+        std::cerr << "Cannot write " << options_.jsonPath << '\n';
+        return false;
+    }
+    std::cout << "Wrote " << options_.jsonPath << '\n';
+    return true;
+}
+
+} // namespace benchmarks
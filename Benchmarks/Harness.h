@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Benchmarks.h"
+
+// Repeated-measurement harness for regression tracking: every case runs a
+// few untimed warmup passes, then N timed repetitions; the report gives
+// per-item percentiles and heap allocations per run, optionally as JSON.
+namespace benchmarks {
+
+struct HarnessOptions {
+    size_t warmup = 2;
+    size_t repetitions = 15;
+    std::string jsonPath;   // Empty: no JSON file
+    std::string filter;     // Only cases whose name contains this
+};
+
+// Takes --warmup=N, --reps=N, --json=PATH and --filter=TEXT out of args;
+// everything else is left in `rest` for the suite
+HarnessOptions parseHarnessOptions(const std::vector<std::string>& args, std::vector<std::string>& rest);
+
+struct Measurement {
+    std::string name;
+    size_t items = 0;                // Work items per run (bytes, calls, ...)
+    std::vector<double> seconds;     // One entry per timed repetition
+    double allocationsPerRun = 0;
+    double min = 0, median = 0, p90 = 0, p99 = 0, mean = 0;  // Seconds per run
+};
+
+class Harness {
+public:
+    Harness(std::string suite, HarnessOptions options);
+
+    // Times fn() and prints one row. Times and allocations are shown per
+    // item (itemsPerRun of them per call); the JSON keeps whole runs.
+    template <typename F>
+    void run(const std::string& name, size_t itemsPerRun, F&& fn) {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) return;
+        for (size_t i = 0; i < options_.warmup; ++i) fn();
+        std::vector<double> seconds;
+        seconds.reserve(options_.repetitions);
+        size_t before = allocationCount();
+        for (size_t i = 0; i < options_.repetitions; ++i) seconds.push_back(timeSeconds(fn));
+        size_t allocations = allocationCount() - before;
+        record(name, itemsPerRun, std::move(seconds), allocations);
+    }
+
+    const std::vector<Measurement>& results() const { return results_; }
+
+    // Writes the JSON report if a path was given; false if it cannot be written
+    bool finish() const;
+
+    std::string toJson() const;
+
+private:
+    void record(const std::string& name, size_t items, std::vector<double> seconds, size_t allocations);
+
+    std::string suite_;
+    HarnessOptions options_;
+    std::vector<Measurement> results_;
+};
+
+} // namespace benchmarks
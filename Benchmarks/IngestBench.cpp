@@ -0,0 +1,118 @@
+#include "Benchmarks.h"
+#include "../Format/DirectoryIngest.h"
+#include "../Format/FormatSecurity.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace benchmarks {
+
+using format_security::DirectoryIngest;
+using format_security::FormatDemo;
+
+namespace {
+
+// count files of 256 B .. 8 KB in directories of 1000, one in 50 with a
+// name isValidFilename rejects
+void makeTree(const std::filesystem::path& root, size_t count) {
+    std::filesystem::remove_all(root);
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<size_t> size(256, 8192);
+    std::string text;
+    for (size_t i = 0; i < count; ++i) {
+        auto dir = root / std::string("d").append(std::to_string(i / 1000));
+        if (i % 1000 == 0) std::filesystem::create_directories(dir);
+        std::string name = (i % 50 == 49) ? "bad%n" + std::to_string(i) : "file" + std::to_string(i) + ".log";
+        text.assign(size(rng), 'x');
+        for (size_t k = 80; k < text.size(); k += 81) text[k] = '\n';
+        std::ofstream(dir / name, std::ios::binary) << text;
+    }
+}
+
+// Drops the tree's pages from the page cache (clean pages need no root)
+void evict(const std::filesystem::path& root) {
+#if defined(__linux__)
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        int fd = ::open(entry.path().c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+#else
+    (void)root;
+#endif
+}
+
+// The current way: one file at a time, validate, open, read, close
+size_t oneAtATime(const std::filesystem::path& root, uint64_t& bytes) {
+    size_t files = 0;
+    const size_t prefix = root.string().size() + 1;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        std::string path = entry.path().string();
+        if (!FormatDemo::isValidFilename(path.substr(prefix))) continue;
+        std::ifstream file(path, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        bytes += contents.size();
+        ++files;
+    }
+    return files;
+}
+
+void report(const char* method, size_t files, uint64_t bytes, double seconds, bool ok) {
+    printf("  %-26s %10.0f files/s %8.1f MB/s%s\n", method, static_cast<double>(files) / seconds,
+           static_cast<double>(bytes) / (1 << 20) / seconds, ok ? "" : "  MISMATCH");
+}
+
+} // namespace
+
+void runIngestBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.empty() ? 20000 : std::stoul(args[0]);
+
+    std::cout << "=== DIRECTORY INGEST BENCHMARK ===\n";
+    std::cout << "io_uring " << (BatchFileReader::ioUringSupported() ? "available" : "unavailable") << '\n';
+    auto root = std::filesystem::temp_directory_path() / "ingest_bench";
+    makeTree(root, count);
+
+    for (bool cold : {false, true}) {
+        std::cout << count << " files, " << (cold ? "cold cache (evicted before each run)" : "warm cache") << ":\n";
+        uint64_t expectedBytes = 0;
+        size_t expectedFiles = 0;
+        if (cold) evict(root);
+        double seconds = timeSeconds([&] { expectedFiles = oneAtATime(root, expectedBytes); });
+        report("one at a time (ifstream)", expectedFiles, expectedBytes, seconds, true);
+
+        struct Variant {
+            const char* name;
+            BatchFileReader::Backend backend;
+            size_t depth;
+        };
+        for (Variant v : {Variant{"thread pool", BatchFileReader::Backend::ThreadPool, 0},
+                          Variant{"io_uring depth 8", BatchFileReader::Backend::IoUring, 8},
+                          Variant{"io_uring depth 64", BatchFileReader::Backend::IoUring, 64},
+                          Variant{"io_uring depth 256", BatchFileReader::Backend::IoUring, 256}}) {
+            if (v.backend == BatchFileReader::Backend::IoUring && !BatchFileReader::ioUringSupported()) continue;
+            DirectoryIngest::Options options;
+            options.read.backend = v.backend;
+            if (v.depth) options.read.queueDepth = v.depth;
+            DirectoryIngest ingest(options);
+            if (cold) evict(root);
+            DirectoryIngest::Stats stats;
+            seconds = timeSeconds([&] { stats = ingest.run(root.string(), nullptr); });
+            report(v.name, stats.read, stats.bytes, seconds, stats.read == expectedFiles && stats.bytes == expectedBytes);
+        }
+    }
+
+    std::filesystem::remove_all(root);
+}
+
+} // namespace benchmarks
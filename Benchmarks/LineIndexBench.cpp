@@ -0,0 +1,127 @@
+#include "Benchmarks.h"
+#include "../Files/FileReader.h"
+#include "../Files/LineIndex.h"
+#include "../Logging/LatencyHistogram.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace benchmarks {
+
+using logging::LatencyHistogram;
+
+namespace {
+
+// Line n the way the current code gets there: getline from the start
+std::string scanToLine(const std::string& path, size_t n) {
+    std::ifstream file(path, std::ios::binary);
+    std::string line;
+    for (size_t i = 0; i <= n && std::getline(file, line); ++i) {}
+    return line;
+}
+
+void reportLatency(const char* method, const LatencyHistogram& latency) {
+    printf("  %-30s p50 %10.2f us  p99 %10.2f us\n", method, static_cast<double>(latency.percentile(0.50)) / 1e3,
+           static_cast<double>(latency.percentile(0.99)) / 1e3);
+}
+
+template <typename F>
+uint64_t nanos(F&& f) {
+    return static_cast<uint64_t>(timeSeconds(std::forward<F>(f)) * 1e9);
+}
+
+} // namespace
+
+void runLineIndexBenchmarks(const std::vector<std::string>& args) {
+    size_t size = args.size() > 0 ? parseSize(args[0]) : 64 * 1024 * 1024;
+    size_t seeks = args.size() > 1 ? std::stoul(args[1]) : 100000;
+    if (size == 0 || seeks == 0) {
+        std::cerr << "Usage: bench index [file size] [seeks]\n";
+        return;
+    }
+
+    std::cout << "=== LINE INDEX BENCHMARK ===\n";
+    auto path = (std::filesystem::temp_directory_path() / "line_index_bench.log").string();
+    std::string sidecar = LineIndex::sidecarPath(path);
+    writeSampleFile(path, size);
+    std::filesystem::remove(sidecar);
+
+    // Building: full scan, then only what an append added
+    LineIndex::BuildStats stats;
+    double full = timeSeconds([&] { LineIndex::build(path, &stats); });
+    size_t indexBytes = static_cast<size_t>(std::filesystem::file_size(sidecar));
+    printf("%s log, %zu lines:\n", formatSize(size).c_str(), stats.lines);
+    printf("  full build                     %10.1f ms  %8.1f MB/s  index %s (%.2f bytes/line)\n", full * 1e3,
+           static_cast<double>(size) / (1 << 20) / full, formatSize(indexBytes).c_str(),
+           static_cast<double>(indexBytes) / static_cast<double>(stats.lines));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        for (size_t i = 0; i < 10000; ++i) out << "2024-01-01T00:00:00Z INFO appended line " << i << '\n';
+    }
+    double incremental = timeSeconds([&] { LineIndex::build(path, &stats); });
+    printf("  rebuild after 10000 appended   %10.1f ms  (%s scanned, %s)\n", incremental * 1e3,
+           formatSize(static_cast<size_t>(stats.scannedBytes)).c_str(),
+           stats.incremental ? "incremental" : "NOT INCREMENTAL");
+
+    LineIndex index(path);
+    if (!index.valid() || !index.upToDate()) {
+        std::cout << "  index unusable\n";
+        return;
+    }
+    std::mt19937_64 rng(24);
+    std::uniform_int_distribution<size_t> pick(0, index.lineCount() - 1);
+
+    std::cout << "Random seeks to line N:\n";
+    LatencyHistogram lookup;
+    size_t checksum = 0;
+    for (size_t i = 0; i < seeks; ++i) {
+        size_t n = pick(rng);
+        lookup.record(nanos([&] { checksum += index.line(n).size(); }));
+    }
+    reportLatency("LineIndex::line", lookup);
+
+    LatencyHistogram range;
+    for (size_t i = 0; i < seeks; ++i) {
+        size_t n = pick(rng);
+        range.record(nanos([&] { checksum += index.lines(n, 100).size(); }));
+    }
+    reportLatency("LineIndex::lines (100 lines)", range);
+
+    // Includes mapping the file and the sidecar and the fingerprint check
+    LatencyHistogram reopen;
+    for (size_t i = 0; i < std::min<size_t>(seeks, 2000); ++i) {
+        size_t n = pick(rng);
+        reopen.record(nanos([&] {
+            LineIndex fresh(path);
+            checksum += fresh.line(n).size();
+        }));
+    }
+    reportLatency("open index + line", reopen);
+
+    // The linear scans are slow; a few seeks give the picture, and double
+    // as the differential check
+    const size_t scans = 20;
+    LatencyHistogram linear, ranged;
+    bool ok = true;
+    for (size_t i = 0; i < scans; ++i) {
+        size_t n = pick(rng);
+        std::string expected;
+        linear.record(nanos([&] { expected = scanToLine(path, n); }));
+        std::string viaReader;
+        ranged.record(nanos([&] {
+            // buildIndex: keep the sidecar built above current (it already is)
+            FileReader(path).forEachLineInRange(n, 1, [&](std::string_view line) { viaReader.assign(line); }, true);
+        }));
+        ok = ok && index.line(n) == expected && viaReader == expected;
+    }
+    reportLatency("getline scan from the start", linear);
+    reportLatency("FileReader::forEachLineInRange", ranged);
+    std::cout << "  " << (ok ? "lines match getline" : "MISMATCH against getline") << '\n';
+    doNotOptimize(checksum);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(sidecar);
+}
+
+} // namespace benchmarks
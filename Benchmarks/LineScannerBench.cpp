@@ -0,0 +1,73 @@
+#include "Benchmarks.h"
+#include "../Files/LineScanner.h"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+namespace benchmarks {
+
+namespace {
+
+const LineScanner::Isa kAllIsas[] = {
+    LineScanner::Isa::Scalar, LineScanner::Isa::SSE2, LineScanner::Isa::AVX2,
+    LineScanner::Isa::AVX512, LineScanner::Isa::NEON,
+};
+
+// Text with empty lines and CRLF endings (tests/LineScannerTest.cpp checks
+// the kernels against getline on the same shapes)
+std::string makeText(size_t bytes, unsigned seed, int maxLine) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> lineLength(0, maxLine);
+    std::uniform_int_distribution<int> crlf(0, 3);
+    std::string text;
+    text.reserve(bytes + static_cast<size_t>(maxLine) + 2);
+    while (text.size() < bytes) {
+        text.append(static_cast<size_t>(lineLength(rng)), 'a' + static_cast<char>(text.size() % 26));
+        if (crlf(rng) == 0) text += '\r';
+        text += '\n';
+    }
+    if (seed % 2) text.resize(bytes);  // Odd seeds end without a terminator
+    return text;
+}
+
+} // namespace
+
+void runLineScannerBenchmarks(const std::vector<std::string>& args) {
+    size_t size = args.empty() ? (256u << 20) : parseSize(args[0]);
+    if (size == 0) size = 256u << 20;
+
+    std::cout << "=== LINE SCANNER BENCHMARK ===\n";
+    LineScanner::Isa detected = LineScanner::activeIsa();
+    std::cout << "Detected ISA: " << LineScanner::isaName(detected) << '\n';
+
+    std::string text = makeText(size, 2, 120);
+    std::cout << "Buffer " << formatSize(text.size()) << ":\n";
+
+    double getlineSeconds = timeSeconds([&] {
+        std::istringstream in(text);
+        size_t lines = 0;
+        for (std::string line; std::getline(in, line); ) ++lines;
+        doNotOptimize(lines);
+    });
+    printf("  %-10s %-12s %8.1f MB/s\n", "getline", "",
+           static_cast<double>(text.size()) / (1 << 20) / getlineSeconds);
+
+    std::vector<LineSpan> spans(1024);
+    for (auto isa : kAllIsas) {
+        if (!LineScanner::forceIsa(isa)) continue;
+        double countSeconds = timeSeconds([&] { doNotOptimize(LineScanner::countLines(text)); });
+        double scanSeconds = timeSeconds([&] {
+            LineScanner scanner(text);
+            size_t lines = 0;
+            while (size_t n = scanner.nextBatch(spans.data(), spans.size())) lines += n;
+            doNotOptimize(lines);
+        });
+        double mb = static_cast<double>(text.size()) / (1 << 20);
+        printf("  %-10s count %8.1f MB/s   batches %8.1f MB/s\n",
+               LineScanner::isaName(isa), mb / countSeconds, mb / scanSeconds);
+    }
+    LineScanner::forceIsa(detected);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,103 @@
+#include "Benchmarks.h"
+#include "../Logging/AsyncLogger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace benchmarks {
+
+using logging::AsyncLogger;
+using logging::LatencyHistogram;
+
+namespace {
+
+void report(const char* method, size_t messages, double seconds, const LatencyHistogram& latency) {
+    printf("  %-24s %8.2f M msg/s   p50 %6llu ns  p99 %7llu ns  p99.9 %8llu ns\n", method,
+           static_cast<double>(messages) / seconds / 1e6,
+           static_cast<unsigned long long>(latency.percentile(0.50)),
+           static_cast<unsigned long long>(latency.percentile(0.99)),
+           static_cast<unsigned long long>(latency.percentile(0.999)));
+}
+
+// Runs `threads` producers, each emitting `perThread` messages through
+// `emit`, timing every call into a per-thread histogram
+template <typename Emit>
+double runProducers(size_t threads, size_t perThread, LatencyHistogram& merged, Emit&& emit) {
+    std::vector<LatencyHistogram> histograms(threads);
+    std::vector<std::thread> workers;
+    double seconds = timeSeconds([&] {
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::string payload = "user-" + std::to_string(t);
+                for (size_t i = 0; i < perThread; ++i) {
+                    auto start = std::chrono::steady_clock::now();
+                    emit(payload, i);
+                    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+                    histograms[t].record(static_cast<uint64_t>(ns.count()));
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+    });
+    for (const auto& h : histograms) merged.merge(h);
+    return seconds;
+}
+
+} // namespace
+
+void runLoggerBenchmarks(const std::vector<std::string>& args) {
+    size_t threads = args.size() > 0 ? std::stoul(args[0]) : 4;
+    size_t perThread = args.size() > 1 ? std::stoul(args[1]) : 200000;
+    size_t total = threads * perThread;
+
+    std::cout << "=== ASYNC LOGGER BENCHMARK ===\n";
+    std::cout << threads << " producer threads x " << perThread << " messages, sink /dev/null\n";
+
+    {
+        // Shared stream, one flush per line (the cout << ... << endl pattern)
+        std::ofstream out("/dev/null");
+        std::mutex mutex;
+        LatencyHistogram latency;
+        double seconds = runProducers(threads, perThread, latency, [&](const std::string& user, size_t i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            out << "Processing " << user << " line " << i << " size " << i * 0.5 << std::endl;
+        });
+        report("ostream + endl", total, seconds, latency);
+    }
+
+    if (FILE* devnull = fopen("/dev/null", "w")) {
+        LatencyHistogram latency;
+        double seconds = runProducers(threads, perThread, latency, [&](const std::string& user, size_t i) {
+            fprintf(devnull, "Processing %s line %zu size %.1f\n", user.c_str(), i, i * 0.5);
+        });
+        report("fprintf (FILE lock)", total, seconds, latency);
+        fclose(devnull);
+    }
+
+    if (FILE* devnull = fopen("/dev/null", "w")) {
+        logging::LoggerOptions options;
+        options.sink = devnull;
+        options.measureLatency = true;
+        LatencyHistogram outer;
+        AsyncLogger::Stats stats;
+        double seconds;
+        {
+            AsyncLogger logger(options);
+            seconds = runProducers(threads, perThread, outer, [&](const std::string& user, size_t i) {
+                logger.info("Processing {} line {} size {:.1f}", user, i, i * 0.5);
+            });
+            logger.flush();
+            stats = logger.stats();
+        }
+        report("AsyncLogger", total, seconds, outer);
+        report("  (inside log())", total, seconds, stats.producerLatency);
+        printf("  records %llu, dropped %llu, %llu batches, %s written\n",
+               static_cast<unsigned long long>(stats.records), static_cast<unsigned long long>(stats.dropped),
+               static_cast<unsigned long long>(stats.batches), formatSize(stats.bytesWritten).c_str());
+        fclose(devnull);
+    }
+}
+
+} // namespace benchmarks
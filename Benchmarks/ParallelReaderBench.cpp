@@ -0,0 +1,93 @@
+#include "Benchmarks.h"
+#include "../Files/FileReader.h"
+#include "../Files/ParallelFileReader.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+namespace benchmarks {
+
+namespace {
+
+// FNV-1a, standing in for real per-line work
+uint64_t hashLine(std::string_view line) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : line) h = (h ^ c) * 1099511628211ULL;
+    return h;
+}
+
+// Folds the line number in, so a wrong numbering changes the checksum even
+// though the sum itself does not depend on delivery order
+uint64_t mix(size_t lineNumber, uint64_t hash) {
+    return hash ^ (static_cast<uint64_t>(lineNumber) * 0x9E3779B97F4A7C15ULL);
+}
+
+} // namespace
+
+void runParallelReaderBenchmarks(const std::vector<std::string>& args) {
+    std::vector<size_t> sizes;
+    size_t maxThreads = std::thread::hardware_concurrency();
+    for (const auto& arg : args) {
+        if (arg.rfind("threads=", 0) == 0) {
+            maxThreads = std::stoul(arg.substr(8));
+        } else if (size_t size = parseSize(arg)) {
+            sizes.push_back(size);
+        }
+    }
+    if (sizes.empty()) sizes = {1u << 20, 16u << 20, 256u << 20};
+    if (maxThreads == 0) maxThreads = 1;
+
+    std::cout << "=== PARALLEL FILE READER BENCHMARK ===\n";
+    auto path = std::filesystem::temp_directory_path() / "filereader_bench.txt";
+
+    for (size_t size : sizes) {
+        writeSampleFile(path, size);
+        double mb = static_cast<double>(size) / (1 << 20);
+        std::cout << "File size " << formatSize(size) << ":\n";
+
+        uint64_t expected = 0;
+        size_t serialLine = 1;
+        FileReader serial(path.string());
+        double serialSeconds = timeSeconds([&] {
+            serial.forEachLine([&](std::string_view line) {
+                expected += mix(serialLine++, hashLine(line));
+            });
+        });
+        printf("  %-8s %7s %10.1f MB/s\n", "serial", "", mb / serialSeconds);
+
+        std::vector<size_t> threadCounts;
+        for (size_t threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+        threadCounts.push_back(maxThreads);
+
+        for (size_t threads : threadCounts) {
+            ParallelFileReader::Options options;
+            options.threads = threads;
+            ParallelFileReader reader(path.string(), options);
+
+            for (auto ordering : {ParallelFileReader::Ordering::Unordered, ParallelFileReader::Ordering::Ordered}) {
+                uint64_t checksum = 0;
+                size_t nextLine = 1;
+                bool inOrder = true;
+                double seconds = timeSeconds([&] {
+                    reader.mapLines(
+                        [](size_t, std::string_view line) { return hashLine(line); },
+                        [&](size_t lineNumber, uint64_t hash) {
+                            inOrder = inOrder && lineNumber == nextLine++;
+                            checksum += mix(lineNumber, hash);
+                        },
+                        ordering);
+                });
+                bool ordered = ordering == ParallelFileReader::Ordering::Ordered;
+                const char* status = checksum != expected ? "  CHECKSUM MISMATCH"
+                                   : ordered && !inOrder ? "  ORDER MISMATCH" : "";
+                printf("  %2zu thr  %-9s %10.1f MB/s  x%.2f%s\n", threads,
+                       ordered ? "ordered" : "unordered", mb / seconds, serialSeconds / seconds, status);
+            }
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,154 @@
+#include "Harness.h"
+#include "../Files/FileReader.h"
+#include "../Format/FormatSecurity.h"
+#include "../Pointers/pointers.h"
+
+#include <filesystem>
+#include <numeric>
+#include <random>
+
+namespace benchmarks {
+
+using format_security::FormatDemo;
+
+namespace {
+
+// Ordinary names plus each kind of rejected one
+std::vector<std::string> makeNames(size_t count) {
+    const char* samples[] = {"example.txt", "logs/app-17/output.log", "../etc/passwd", "report%n.txt",
+                             "", "data\nfile.txt", "archive/2024/q3/summary-final.csv"};
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i) names.push_back(samples[i % std::size(samples)]);
+    return names;
+}
+
+std::vector<std::string> makeInputs(size_t count) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> length(4, 200), byte(1, 127);
+    std::vector<std::string> inputs(count);
+    for (auto& input : inputs) {
+        input.resize(static_cast<size_t>(length(rng)));
+        for (char& c : input) c = static_cast<char>(byte(rng));
+    }
+    return inputs;
+}
+
+void fileReaderCases(Harness& harness, size_t fileSize) {
+    auto path = std::filesystem::temp_directory_path() / "regression_bench.txt";
+    writeSampleFile(path, fileSize);
+    FileReader reader(path.string());
+
+    NullBuffer null;
+    std::streambuf* saved = std::cout.rdbuf(&null);
+    harness.run("FileReader::readFileOldStyle", fileSize, [&] { reader.readFileOldStyle(); });
+    harness.run("FileReader::readFileModernStyle", fileSize, [&] { reader.readFileModernStyle(); });
+    std::cout.rdbuf(saved);
+
+    harness.run("FileReader::forEachLine", fileSize, [&] {
+        size_t chars = 0;
+        reader.forEachLine([&](std::string_view line) { chars += line.size(); });
+        doNotOptimize(chars);
+    });
+    harness.run("FileReader::countLines", fileSize, [&] { doNotOptimize(reader.countLines()); });
+    std::filesystem::remove(path);
+}
+
+void formatCases(Harness& harness, size_t count) {
+    auto names = makeNames(count);
+    auto inputs = makeInputs(count);
+    harness.run("FormatDemo::isValidFilename", count, [&] {
+        size_t valid = 0;
+        for (const auto& name : names) valid += FormatDemo::isValidFilename(name);
+        doNotOptimize(valid);
+    });
+    harness.run("FormatDemo::sanitizeInput", count, [&] {
+        for (const auto& input : inputs) doNotOptimize(FormatDemo::sanitizeInput(input));
+    });
+    std::string reused;
+    harness.run("FormatDemo::sanitizeInto (reused)", count, [&] {
+        for (const auto& input : inputs) {
+            FormatDemo::sanitizeInto(input, reused);
+            doNotOptimize(reused);
+        }
+    });
+}
+
+// The container patterns of the ptrdemo vector and ownership demos
+void containerCases(Harness& harness, size_t count) {
+    harness.run("vector push_back x10 (modernVectorGood)", count, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<int> v;
+            for (int k = 0; k < 10; ++k) v.push_back(k * 10);
+            doNotOptimize(v.data());
+        }
+    });
+    harness.run("SmallVector<int, 16> push_back x10", count, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            ptrdemo::SmallVector<int, 16> v;
+            for (int k = 0; k < 10; ++k) v.push_back(k * 10);
+            doNotOptimize(v.data());
+        }
+    });
+
+    std::vector<int> v2 = {10, 20, 30};
+    harness.run("vector insert merge (vectorRangeExample)", count, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            std::vector<int> v1 = {1, 2, 3};
+            v1.insert(v1.end(), v2.begin(), v2.end());
+            doNotOptimize(v1.data());
+        }
+    });
+    harness.run("vector reserve + push_back x1000", 1000, [&] {
+        std::vector<int> v3;
+        v3.reserve(1000);
+        for (int i = 0; i < 1000; ++i) v3.push_back(i);
+        doNotOptimize(v3.data());
+    });
+
+    std::vector<int> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    ptrdemo::CheckedSpan<const int> span(values);
+    harness.run("CheckedSpan indexed sum", count, [&] {
+        long long total = 0;
+        for (size_t i = 0; i < span.size(); ++i) total += span[i];
+        doNotOptimize(total);
+    });
+
+    harness.run("makeSafeInt", count, [&] {
+        for (size_t i = 0; i < count; ++i) doNotOptimize(ptrdemo::makeSafeInt());
+    });
+    auto shared = ptrdemo::makeSharedString("hello from a shared string");
+    harness.run("shared_ptr<string> copy", count, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            auto copy = shared;
+            doNotOptimize(copy);
+        }
+    });
+    auto intrusive = ptrdemo::makeIntrusiveString("hello from a shared string");
+    harness.run("SharedString copy", count, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            auto copy = intrusive;
+            doNotOptimize(copy);
+        }
+    });
+}
+
+} // namespace
+
+void runRegressionBenchmarks(const std::vector<std::string>& args) {
+    std::vector<std::string> rest;
+    HarnessOptions options = parseHarnessOptions(args, rest);
+    size_t fileSize = rest.empty() ? (4u << 20) : parseSize(rest[0]);
+    if (fileSize == 0) fileSize = 4u << 20;
+    const size_t count = 100000;
+
+    std::cout << "=== REGRESSION BENCHMARK === (" << options.warmup << " warmup, " << options.repetitions
+              << " repetitions, " << formatSize(fileSize) << " file)\n";
+    Harness harness("regress", options);
+    fileReaderCases(harness, fileSize);
+    formatCases(harness, count);
+    containerCases(harness, count);
+    harness.finish();
+}
+
+} // namespace benchmarks
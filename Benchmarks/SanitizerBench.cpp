@@ -0,0 +1,95 @@
+#include "Benchmarks.h"
+#include "../Format/FormatSecurity.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+namespace benchmarks {
+
+using format_security::FormatDemo;
+
+namespace {
+
+// The original sanitizeInput: copy, three replace passes, substr
+std::string legacySanitize(const std::string& input) {
+    std::string result = input;
+    std::replace(result.begin(), result.end(), '%', '_');
+    std::replace(result.begin(), result.end(), '\n', '_');
+    std::replace(result.begin(), result.end(), '\r', '_');
+    if (result.length() > 100) {
+        result = result.substr(0, 100);
+    }
+    return result;
+}
+
+std::vector<std::string> makeInputs(size_t count) {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> length(4, 300), byte(1, 127);
+    std::vector<std::string> inputs(count);
+    for (auto& input : inputs) {
+        input.resize(static_cast<size_t>(length(rng)));
+        for (char& c : input) c = static_cast<char>(byte(rng));
+    }
+    return inputs;
+}
+
+void report(const char* method, size_t calls, double seconds, size_t allocs) {
+    printf("  %-26s %8.1f ns/call %8.2f allocs/call\n", method,
+           seconds * 1e9 / static_cast<double>(calls), static_cast<double>(allocs) / static_cast<double>(calls));
+}
+
+} // namespace
+
+void runSanitizerBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.empty() ? 1000000 : std::stoul(args[0]);
+
+    std::cout << "=== SANITIZER BENCHMARK ===\n";
+    auto inputs = makeInputs(count);
+
+    // Every variant must agree with the original implementation
+    size_t mismatches = 0;
+    char stack[FormatDemo::maxSanitizedLength];
+    std::string reused;
+    for (const auto& input : inputs) {
+        std::string expected = legacySanitize(input);
+        std::string inPlace = input;
+        FormatDemo::sanitizeInPlace(inPlace);
+        FormatDemo::sanitizeInto(input, reused);
+        size_t n = FormatDemo::sanitizeInto(input, stack);
+        mismatches += FormatDemo::sanitizeInput(input) != expected || inPlace != expected ||
+                      reused != expected || std::string_view(stack, n) != expected;
+    }
+    std::cout << "Check vs original sanitizeInput: " << (mismatches ? "FAILED" : "ok") << '\n';
+
+    size_t sink = 0;
+    auto measure = [&](const char* method, auto&& body) {
+        size_t before = allocationCount();
+        double seconds = timeSeconds([&] {
+            for (const auto& input : inputs) body(input);
+        });
+        report(method, inputs.size(), seconds, allocationCount() - before);
+    };
+
+    measure("original (3x replace)", [&](const std::string& in) { sink += legacySanitize(in).size(); });
+    measure("sanitizeInput", [&](const std::string& in) { sink += FormatDemo::sanitizeInput(in).size(); });
+    measure("sanitizeInto(stack span)", [&](const std::string& in) {
+        sink += FormatDemo::sanitizeInto(in, stack);
+    });
+    reused.reserve(FormatDemo::maxSanitizedLength);
+    measure("sanitizeInto(reused string)", [&](const std::string& in) {
+        FormatDemo::sanitizeInto(in, reused);
+        sink += reused.size();
+    });
+
+    // In place mutates its input, so it runs over a prepared copy
+    auto copies = inputs;
+    size_t before = allocationCount();
+    double seconds = timeSeconds([&] {
+        for (auto& text : copies) FormatDemo::sanitizeInPlace(text);
+    });
+    report("sanitizeInPlace", copies.size(), seconds, allocationCount() - before);
+    doNotOptimize(sink);
+}
+
+} // namespace benchmarks
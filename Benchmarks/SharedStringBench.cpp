@@ -0,0 +1,89 @@
+#include "Benchmarks.h"
+#include "../Pointers/pointers.h"
+
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace benchmarks {
+
+using ptrdemo::LocalSharedString;
+using ptrdemo::SharedString;
+
+namespace {
+
+// Copies the handle `copies` times into a reused vector, touches every
+// copy, then destroys them: the runAllSafe `auto sp2 = sp1;` pattern at scale
+template <typename Handle, typename Size>
+double copyAccessDestroy(const Handle& original, size_t copies, Size&& sizeOf) {
+    std::vector<Handle> held;
+    held.reserve(copies);
+    size_t total = 0;
+    auto pass = [&] {
+        for (size_t i = 0; i < copies; ++i) held.push_back(original);
+        for (const auto& h : held) total += sizeOf(h);
+        held.clear();
+    };
+    pass();  // Warm up: fault in the vector's pages
+    double seconds = timeSeconds(pass);
+    doNotOptimize(total);
+    return seconds;
+}
+
+// All threads copy and drop the same handle: contended refcount
+template <typename Handle>
+double contended(const Handle& original, size_t threads, size_t perThread) {
+    std::vector<std::thread> workers;
+    return timeSeconds([&] {
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (size_t i = 0; i < perThread; ++i) {
+                    Handle copy = original;
+                    doNotOptimize(copy);
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+    });
+}
+
+void report(const char* method, size_t ops, double seconds) {
+    printf("  %-34s %8.2f ns/op\n", method, seconds * 1e9 / static_cast<double>(ops));
+}
+
+} // namespace
+
+void runSharedStringBenchmarks(const std::vector<std::string>& args) {
+    size_t copies = args.size() > 0 ? std::stoul(args[0]) : 4000000;
+    size_t threads = args.size() > 1 ? std::stoul(args[1]) : 4;
+
+    std::cout << "=== SHARED STRING BENCHMARK ===\n";
+    auto sharedSize = [](const std::shared_ptr<std::string>& p) { return p->size(); };
+    auto handleSize = [](const auto& s) { return s.size(); };
+
+    for (const std::string& text : {std::string("short"), std::string(64, 's')}) {
+        std::cout << "String of " << text.size() << " chars, single thread (copy + access + destroy):\n";
+        auto sp = ptrdemo::makeSharedString(text);
+        report("shared_ptr<string>", copies, copyAccessDestroy(sp, copies, sharedSize));
+        report("SharedString (atomic)", copies, copyAccessDestroy(ptrdemo::makeIntrusiveString(text), copies, handleSize));
+        report("LocalSharedString (non-atomic)", copies, copyAccessDestroy(LocalSharedString(text), copies, handleSize));
+
+        size_t creates = copies / 4;
+        report("create makeSharedString", creates, timeSeconds([&] {
+            for (size_t i = 0; i < creates; ++i) doNotOptimize(ptrdemo::makeSharedString(text));
+        }));
+        report("create makeIntrusiveString", creates, timeSeconds([&] {
+            for (size_t i = 0; i < creates; ++i) doNotOptimize(ptrdemo::makeIntrusiveString(text));
+        }));
+    }
+
+    std::string text(64, 'm');
+    size_t perThread = copies / threads;
+    std::cout << threads << " threads copying one shared handle (64 chars):\n";
+    report("shared_ptr<string>", perThread * threads,
+           contended(ptrdemo::makeSharedString(text), threads, perThread));
+    report("SharedString (atomic)", perThread * threads,
+           contended(ptrdemo::makeIntrusiveString(text), threads, perThread));
+}
+
+} // namespace benchmarks
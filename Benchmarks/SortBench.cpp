@@ -0,0 +1,162 @@
+#include "Benchmarks.h"
+#include "../Sorting/Sorting.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <thread>
+#ifdef BENCH_WITH_EXECUTION_PAR
+#include <execution>
+#endif
+
+// std::execution::par needs a parallel backend; with libstdc++ that means
+// TBB, so it is opt-in: -DBENCH_WITH_EXECUTION_PAR ... -ltbb
+
+namespace benchmarks {
+
+namespace {
+
+enum class Distribution { Uniform, FewUnique, Sorted, Reversed, NearlySorted };
+
+const char* distributionName(Distribution d) {
+    switch (d) {
+    case Distribution::Uniform: return "uniform";
+    case Distribution::FewUnique: return "few-unique";
+    case Distribution::Sorted: return "sorted";
+    case Distribution::Reversed: return "reversed";
+    case Distribution::NearlySorted: return "nearly-sorted";
+    }
+    return "?";
+}
+
+template <typename T>
+void fill(std::vector<T>& values, Distribution d, std::mt19937_64& rng) {
+    size_t n = values.size();
+    switch (d) {
+    case Distribution::Uniform:
+        for (T& v : values) v = static_cast<T>(rng());
+        break;
+    case Distribution::FewUnique:
+        for (T& v : values) v = static_cast<T>(rng() % 16);
+        break;
+    case Distribution::Sorted:
+    case Distribution::Reversed:
+    case Distribution::NearlySorted:
+        for (size_t i = 0; i < n; ++i) values[i] = static_cast<T>(i);
+        if (d == Distribution::Reversed) std::reverse(values.begin(), values.end());
+        if (d == Distribution::NearlySorted) {
+            for (size_t i = 0; i < n / 100; ++i) std::swap(values[rng() % n], values[rng() % n]);
+        }
+        break;
+    }
+}
+
+// Times sortFn on a fresh copy of input and checks the result against
+// the std::sort reference
+template <typename T, typename SortFn>
+void measure(const char* method, const std::vector<T>& input, const std::vector<T>& expected,
+             std::vector<T>& work, SortFn&& sortFn) {
+    work = input;
+    double seconds = timeSeconds([&] { sortFn(work); });
+    printf("  %-28s %9.2f ms %8.1f M elements/s%s\n", method, seconds * 1e3,
+           static_cast<double>(input.size()) / seconds / 1e6, work == expected ? "" : "  MISMATCH");
+}
+
+template <typename T>
+void sweep(const char* typeName, size_t n, const std::vector<size_t>& threadCounts) {
+    std::mt19937_64 rng(13);
+    std::vector<T> input(n), expected, work;
+    for (Distribution d : {Distribution::Uniform, Distribution::FewUnique, Distribution::Sorted,
+                           Distribution::Reversed, Distribution::NearlySorted}) {
+        fill(input, d, rng);
+        std::cout << n << " x " << typeName << ", " << distributionName(d) << ":\n";
+
+        expected = input;
+        double stdSeconds = timeSeconds([&] { std::sort(expected.begin(), expected.end()); });
+        printf("  %-28s %9.2f ms %8.1f M elements/s\n", "std::sort", stdSeconds * 1e3,
+               static_cast<double>(n) / stdSeconds / 1e6);
+#ifdef BENCH_WITH_EXECUTION_PAR
+        measure("std::sort(execution::par)", input, expected, work,
+                [](std::vector<T>& v) { std::sort(std::execution::par, v.begin(), v.end()); });
+#endif
+        measure("radixSort", input, expected, work, [](std::vector<T>& v) { sorting::radixSort<T>(v); });
+        for (size_t threads : threadCounts) {
+            sorting::ParallelSorter sorter({threads});
+            char label[64];
+            snprintf(label, sizeof(label), "ParallelSorter %zu thread%s", threads, threads == 1 ? "" : "s");
+            measure(label, input, expected, work, [&](std::vector<T>& v) { sorter.sort<T>(v); });
+        }
+    }
+}
+
+// k presorted runs into one vector: kWayMerge vs the insert + sort and
+// pairwise std::merge approaches
+void mergeSweep(size_t n) {
+    std::mt19937_64 rng(17);
+    for (size_t k : {2, 8, 64}) {
+        std::vector<std::vector<int>> runs(k);
+        for (auto& run : runs) {
+            run.resize(n / k);
+            for (int& v : run) v = static_cast<int>(rng());
+            std::sort(run.begin(), run.end());
+        }
+        size_t total = (n / k) * k;
+        std::cout << "Merge " << k << " presorted runs, " << total << " ints:\n";
+
+        std::vector<int> concatenated;
+        double insertSort = timeSeconds([&] {
+            concatenated.clear();
+            for (const auto& run : runs) concatenated.insert(concatenated.end(), run.begin(), run.end());
+            std::sort(concatenated.begin(), concatenated.end());
+        });
+
+        std::vector<int> pairwise;
+        double pairwiseSeconds = timeSeconds([&] {
+            pairwise.clear();
+            std::vector<int> next;
+            for (const auto& run : runs) {
+                next.resize(pairwise.size() + run.size());
+                std::merge(pairwise.begin(), pairwise.end(), run.begin(), run.end(), next.begin());
+                pairwise.swap(next);
+            }
+        });
+
+        std::vector<int> merged(total);
+        std::vector<std::span<const int>> views(runs.begin(), runs.end());
+        double kway = timeSeconds([&] { sorting::kWayMerge<int>(views, merged); });
+
+        bool ok = merged == concatenated && merged == pairwise;
+        printf("  %-28s %9.2f ms\n", "insert + std::sort", insertSort * 1e3);
+        printf("  %-28s %9.2f ms\n", "sequential std::merge", pairwiseSeconds * 1e3);
+        printf("  %-28s %9.2f ms%s\n", "kWayMerge", kway * 1e3, ok ? "" : "  MISMATCH");
+    }
+}
+
+} // namespace
+
+void runSortBenchmarks(const std::vector<std::string>& args) {
+    std::vector<size_t> sizes;
+    size_t maxThreads = std::thread::hardware_concurrency();
+    for (const auto& arg : args) {
+        if (arg.rfind("threads=", 0) == 0) {
+            maxThreads = std::stoul(arg.substr(8));
+        } else if (size_t size = parseSize(arg)) {
+            sizes.push_back(size);
+        }
+    }
+    if (sizes.empty()) sizes = {1u << 20, 16u << 20};
+    if (maxThreads == 0) maxThreads = 1;
+
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "=== SORT BENCHMARK ===\n";
+    for (size_t n : sizes) {
+        sweep<int32_t>("int32", n, threadCounts);
+        sweep<uint64_t>("uint64", n, threadCounts);
+        mergeSweep(n);
+    }
+}
+
+} // namespace benchmarks
@@ -0,0 +1,58 @@
+#include "Benchmarks.h"
+#include "../overandunderflow/SpanReduce.h"
+
+#include <cstdio>
+#include <random>
+
+namespace benchmarks {
+
+using safe_math::ReduceIsa;
+
+void runSpanReduceBenchmarks(const std::vector<std::string>& args) {
+    size_t count = args.empty() ? (1u << 26) : std::stoul(args[0]);
+
+    std::cout << "=== OVERFLOW-CHECKED REDUCTION BENCHMARK ===\n";
+    std::cout << "Detected ISA: " << safe_math::reduceIsaName(safe_math::activeReduceIsa()) << '\n';
+    ReduceIsa detected = safe_math::activeReduceIsa();
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> small(-1000, 1000);
+    std::uniform_int_distribution<int> large(0, 2000);
+    std::vector<int> values(count);
+    double mb = static_cast<double>(count * sizeof(int)) / (1 << 20);
+
+    // "safe": small mixed-sign values, never near the limits;
+    // "overflowing": large positive drift, overflows early on
+    for (const char* dataset : {"safe", "overflowing"}) {
+        bool safe = dataset[0] == 's';
+        for (int& v : values) v = safe ? small(rng) : large(rng) * 1000;
+        std::cout << "Dataset " << dataset << " (" << count << " ints):\n";
+
+        long long expected = 0;
+        size_t firstIndex = count;
+        double naive = timeSeconds([&] {
+            int acc = 0;
+            bool hit = false;
+            for (size_t i = 0; i < count; ++i) {
+                expected += values[i];
+                if (__builtin_add_overflow(acc, values[i], &acc) && !hit) {
+                    hit = true;
+                    firstIndex = i;
+                }
+            }
+        });
+        printf("  %-24s %10.1f MB/s\n", "scalar __builtin loop", mb / naive);
+
+        for (auto isa : {ReduceIsa::Scalar, ReduceIsa::SSE41, ReduceIsa::AVX2, ReduceIsa::NEON}) {
+            if (!safe_math::forceReduceIsa(isa)) continue;
+            safe_math::ReduceResult result;
+            double seconds = timeSeconds([&] { result = safe_math::reduce(values); });
+            bool ok = result.sum == expected && result.firstIndex == firstIndex;
+            printf("  reduce %-17s %10.1f MB/s  first overflow %zu%s\n", safe_math::reduceIsaName(isa),
+                   mb / seconds, result.firstIndex, ok ? "" : "  MISMATCH");
+        }
+    }
+    safe_math::forceReduceIsa(detected);
+}
+
+} // namespace benchmarks
@@ -0,0 +1,134 @@
+#include "Benchmarks.h"
+#include "../Format/FormatSecurity.h"
+#include "../Format/ValidationCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+namespace benchmarks {
+
+using format_security::FormatDemo;
+using format_security::ValidationCache;
+
+namespace {
+
+// Path-like inputs of 8..120 characters; about one in ten is invalid
+// (traversal or a control byte) and some are long enough to be truncated
+std::vector<std::string> makeInputs(size_t count) {
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> length(8, 120), kind(0, 19);
+    std::vector<std::string> inputs;
+    inputs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string text = "logs/" + std::to_string(i) + "/";
+        size_t target = static_cast<size_t>(length(rng));
+        while (text.size() < target) text += static_cast<char>('a' + rng() % 26);
+        switch (kind(rng)) {
+            case 0: text += "/../etc"; break;
+            case 1: text[text.size() / 2] = '\x07'; break;
+            case 2: text += "<%s>"; break;
+            default: text += ".log"; break;
+        }
+        inputs.push_back(std::move(text));
+    }
+    return inputs;
+}
+
+// Zipf(s) over [0, distinct): rank k is drawn with probability ~ 1 / (k+1)^s
+std::vector<uint32_t> zipfTrace(size_t distinct, size_t lookups, double s, uint32_t seed) {
+    std::vector<double> cdf(distinct);
+    double sum = 0;
+    for (size_t k = 0; k < distinct; ++k) cdf[k] = sum += 1.0 / std::pow(static_cast<double>(k + 1), s);
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::vector<uint32_t> trace(lookups);
+    for (uint32_t& index : trace) {
+        auto it = std::upper_bound(cdf.begin(), cdf.end(), uniform(rng));
+        index = static_cast<uint32_t>(std::min<size_t>(it - cdf.begin(), distinct - 1));
+    }
+    return trace;
+}
+
+void report(const char* label, size_t ops, double seconds, size_t allocations, const char* extra) {
+    printf("  %-30s %8.1f ns/op  %6.2f allocs/op  %s\n", label, seconds * 1e9 / static_cast<double>(ops),
+           static_cast<double>(allocations) / static_cast<double>(ops), extra);
+}
+
+// Runs `trace` split over `threads` workers, each calling work(index)
+template <typename Work>
+double runThreads(const std::vector<uint32_t>& trace, size_t threads, Work&& work) {
+    return timeSeconds([&] {
+        std::vector<std::thread> workers;
+        size_t per = trace.size() / threads;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                size_t end = t + 1 == threads ? trace.size() : (t + 1) * per;
+                for (size_t i = t * per; i < end; ++i) work(trace[i]);
+            });
+        }
+        for (std::thread& worker : workers) worker.join();
+    });
+}
+
+} // namespace
+
+void runValidationCacheBenchmarks(const std::vector<std::string>& args) {
+    size_t distinct = args.size() > 0 ? parseSize(args[0]) : 100000;
+    size_t lookups = args.size() > 1 ? parseSize(args[1]) : 2000000;
+    size_t maxThreads = std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "=== VALIDATION CACHE BENCHMARK ===\n";
+    std::vector<std::string> inputs = makeInputs(distinct);
+
+    // Differential check against the uncached helpers, through evictions
+    {
+        ValidationCache cache(ValidationCache::Options{64 * 1024, 4});
+        std::vector<uint32_t> trace = zipfTrace(distinct, 200000, 1.0, 7);
+        size_t mismatches = 0;
+        for (uint32_t index : trace) {
+            auto result = cache.lookup(inputs[index]);
+            mismatches += result.valid != FormatDemo::isValidFilename(inputs[index]) ||
+                          result.sanitized.view() != FormatDemo::sanitizeInput(inputs[index]);
+        }
+        printf("Differential check: %zu lookups, %zu mismatches%s\n", trace.size(), mismatches,
+               mismatches ? "  MISMATCH" : "");
+    }
+
+    for (double s : {1.0, 1.2}) {
+        std::vector<uint32_t> trace = zipfTrace(distinct, lookups, s, 42);
+        printf("\n%zu distinct inputs, %zu lookups, Zipf s=%.1f:\n", distinct, lookups, s);
+
+        for (size_t threads : {size_t{1}, maxThreads}) {
+            printf(" %zu thread%s:\n", threads, threads == 1 ? "" : "s");
+            size_t before = allocationCount();
+            double seconds = runThreads(trace, threads, [&](uint32_t index) {
+                bool valid = FormatDemo::isValidFilename(inputs[index]);
+                std::string sanitized = FormatDemo::sanitizeInput(inputs[index]);
+                doNotOptimize(valid);
+                doNotOptimize(sanitized);
+            });
+            report("uncached", trace.size(), seconds, allocationCount() - before, "");
+
+            for (size_t capacity : {size_t{256} * 1024, size_t{2} * 1024 * 1024, size_t{32} * 1024 * 1024}) {
+                ValidationCache cache(ValidationCache::Options{capacity, 16});
+                before = allocationCount();
+                seconds = runThreads(trace, threads, [&](uint32_t index) {
+                    ValidationCache::Result result = cache.lookup(inputs[index]);
+                    doNotOptimize(result);
+                });
+                size_t allocations = allocationCount() - before;
+                ValidationCache::Stats stats = cache.stats();
+                char extra[128];
+                snprintf(extra, sizeof(extra), "hit rate %5.1f%%, %zu entries in %s", 100.0 * static_cast<double>(stats.hits) /
+                         static_cast<double>(stats.hits + stats.misses), stats.entries, formatSize(stats.bytes).c_str());
+                std::string label = "cache " + formatSize(capacity);
+                report(label.c_str(), trace.size(), seconds, allocations, extra);
+            }
+        }
+    }
+}
+
+} // namespace benchmarks
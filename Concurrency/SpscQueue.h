@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Bounded single-producer/single-consumer ring. Each side caches the other
+// side's index and only reloads it when the ring looks full (or empty), so
+// the shared cache lines move between cores once per burst rather than
+// once per item. push/pop block when the ring is full/empty: a short spin,
+// then std::atomic::wait. A full ring is how a slow consumer pushes back on
+// its producer.
+template <typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit SpscQueue(size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<T[]>(capacity_)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side
+    bool tryPush(T value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == capacity_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == capacity_) return false;
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        tail_.notify_one();
+        return true;
+    }
+
+    void push(T value) {
+        for (int spin = 0; !tryPush(std::move(value)); ++spin) {
+            if (spin < kSpins) continue;
+            // Sleep until the consumer moves head past the value seen full
+            head_.wait(tail_.load(std::memory_order_relaxed) - capacity_, std::memory_order_acquire);
+        }
+    }
+
+    // Consumer side
+    bool tryPop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return false;
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        head_.notify_one();
+        return true;
+    }
+
+    T pop() {
+        T value;
+        for (int spin = 0; !tryPop(value); ++spin) {
+            if (spin < kSpins) continue;
+            tail_.wait(head_.load(std::memory_order_relaxed), std::memory_order_acquire);
+        }
+        return value;
+    }
+
+    // Approximate when called concurrently with push/pop
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr int kSpins = 64;
+    static constexpr size_t kLine = 64;
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    alignas(kLine) std::atomic<size_t> head_{0};  // Written by the consumer
+    size_t cachedTail_ = 0;                       // Consumer's copy of tail_
+    alignas(kLine) std::atomic<size_t> tail_{0};  // Written by the producer
+    size_t cachedHead_ = 0;                       // Producer's copy of head_
+};
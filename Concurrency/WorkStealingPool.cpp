@@ -0,0 +1,118 @@
+#include "WorkStealingPool.h"
+
+#include <utility>
+
+namespace {
+
+// Identifies the pool and deque of the current worker thread
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    for (size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+    for (size_t i = 0; i < threads; ++i) workers_.emplace_back([this, i] { workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void WorkStealingPool::submit(Task task) {
+    size_t target = currentPool == this
+        ? currentIndex
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    {
+        // Count before publishing so a waking worker never misses the task
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++queued_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    idle_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    if (std::exception_ptr error = std::exchange(error_, nullptr)) {
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+}
+
+bool WorkStealingPool::tryRunPending() {
+    Task task;
+    size_t self = currentPool == this ? currentIndex : 0;
+    if (!popOrSteal(self, task)) return false;
+    run(task);
+    return true;
+}
+
+bool WorkStealingPool::popOrSteal(size_t self, Task& task) {
+    {
+        Queue& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (size_t k = 1; !task && k < queues_.size(); ++k) {
+        Queue& victim = *queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    --queued_;
+    return true;
+}
+
+void WorkStealingPool::run(Task& task) {
+    // A throwing task must still count as finished, or wait() never returns
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        if (!error_) error_ = std::current_exception();
+    }
+    task = nullptr;
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        idle_.notify_all();
+    }
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    Task task;
+    for (;;) {
+        if (popOrSteal(index, task)) {
+            run(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0) return;
+    }
+}
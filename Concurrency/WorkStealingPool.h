@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool with one task deque per worker. Workers pop their
+// own deque LIFO (cache-warm) and steal FIFO from the others when empty, so
+// uneven tasks (e.g. chunks with very different line densities) balance out.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads == 0 uses std::thread::hardware_concurrency()
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Called from a worker, the task goes to that worker's own deque;
+    // otherwise deques are filled round-robin.
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished, then rethrows the
+    // first exception a task threw since the last wait() (later ones are
+    // dropped). Must not be called from inside a task (use tryRunPending
+    // to help instead).
+    void wait();
+
+    // Runs one queued task on the calling thread if there is one; lets a
+    // task that waits on subtasks help instead of blocking a worker.
+    bool tryRunPending();
+
+    size_t size() const { return workers_.size(); }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popOrSteal(size_t self, Task& task);
+    void run(Task& task);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    size_t queued_ = 0;             // Tasks sitting in deques (guarded by sleepMutex_)
+    std::atomic<size_t> pending_{0}; // Queued + running
+    std::exception_ptr error_;       // First task exception (guarded by sleepMutex_)
+    std::atomic<size_t> nextQueue_{0};
+    bool stop_ = false;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+// Lazy asynchronous sequence produced by a coroutine that may co_await
+// between its co_yields (e.g. reads on an IoLoop). The consumer is itself a
+// coroutine:
+//
+//   while (auto line = co_await lines.next()) use(*line);
+//
+// next() transfers control straight into the producer, and co_yield
+// transfers straight back (symmetric transfer), so neither side grows the
+// stack and no scheduler is involved unless the producer waits for I/O.
+// A yielded value stays valid until the following next(). Exceptions from
+// the producer are rethrown by next().
+template <typename T>
+class AsyncGenerator {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // Resumes whoever is waiting in next()
+    struct ToConsumer {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle producer) noexcept { return producer.promise().consumer; }
+        void await_resume() noexcept {}
+    };
+
+    struct promise_type {
+        std::optional<T> current;
+        std::coroutine_handle<> consumer;
+        std::exception_ptr error;
+
+        AsyncGenerator get_return_object() { return AsyncGenerator(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        ToConsumer final_suspend() noexcept { return {}; }
+        ToConsumer yield_value(T value) {
+            current.emplace(std::move(value));
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    class NextAwaiter {
+    public:
+        explicit NextAwaiter(Handle producer) : producer_(producer) {}
+
+        bool await_ready() const noexcept { return !producer_ || producer_.done(); }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+            producer_.promise().consumer = consumer;
+            producer_.promise().current.reset();
+            return producer_;
+        }
+        // The next value, or nullopt once the producer has finished
+        std::optional<T> await_resume() {
+            if (!producer_) return std::nullopt;
+            if (producer_.done()) {
+                if (auto error = std::exchange(producer_.promise().error, nullptr)) std::rethrow_exception(error);
+                return std::nullopt;
+            }
+            return std::move(producer_.promise().current);
+        }
+
+    private:
+        Handle producer_;
+    };
+
+    AsyncGenerator() = default;
+    AsyncGenerator(AsyncGenerator&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    AsyncGenerator& operator=(AsyncGenerator&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    ~AsyncGenerator() {
+        if (handle_) handle_.destroy();
+    }
+
+    NextAwaiter next() { return NextAwaiter(handle_); }
+
+private:
+    explicit AsyncGenerator(Handle handle) : handle_(handle) {}
+
+    Handle handle_;
+};
@@ -0,0 +1,305 @@
+#include "BatchFileReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "IoUringRing.h"
+
+namespace {
+
+constexpr size_t kInitialBuffer = 64 * 1024;
+
+// Growable read buffer; unlike vector<char>, growing does not zero-fill
+struct ReadBuffer {
+    std::unique_ptr<char[]> data;
+    size_t capacity = 0;
+
+    void reserve(size_t wanted, size_t keep) {
+        if (wanted <= capacity) return;
+        auto bigger = std::make_unique_for_overwrite<char[]>(wanted);
+        if (keep) std::memcpy(bigger.get(), data.get(), keep);
+        data = std::move(bigger);
+        capacity = wanted;
+    }
+};
+
+// Fallback: the whole file with open + pread; fstat sizes the first read
+int readWholeFile(const std::string& path, ReadBuffer& buffer, size_t maxSize, size_t& size) {
+    size = 0;
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return errno;
+    struct stat st {};
+    size_t hint = kInitialBuffer;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) hint = static_cast<size_t>(st.st_size) + 1;
+    buffer.reserve(std::min(hint, maxSize + 1), 0);
+
+    int error = 0;
+    for (;;) {
+        if (size == buffer.capacity) {
+            if (size > maxSize) {
+                error = EFBIG;
+                break;
+            }
+            buffer.reserve(std::min(buffer.capacity * 2, maxSize + 1), size);
+        }
+        ssize_t n = ::pread(fd, buffer.data.get() + size, buffer.capacity - size, static_cast<off_t>(size));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = errno;
+            break;
+        }
+        if (n == 0) break;
+        size += static_cast<size_t>(n);
+    }
+    if (!error && size > maxSize) error = EFBIG;
+    ::close(fd);
+    return error;
+#else
+    (void)path;
+    (void)buffer;
+    (void)maxSize;
+    return ENOSYS;
+#endif
+}
+
+} // namespace
+
+BatchFileReader::BatchFileReader() : BatchFileReader(Options{}) {}
+
+BatchFileReader::BatchFileReader(Options options) : options_(options) {
+    options_.queueDepth = std::clamp<size_t>(options_.queueDepth, 1, 4096);
+    backend_ = options_.backend;
+    if (backend_ == Backend::Auto) backend_ = ioUringSupported() ? Backend::IoUring : Backend::ThreadPool;
+}
+
+BatchFileReader::~BatchFileReader() = default;
+
+const char* BatchFileReader::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Auto: return "auto";
+        case Backend::IoUring: return "io_uring";
+        case Backend::ThreadPool: return "thread pool";
+    }
+    return "?";
+}
+
+bool BatchFileReader::ioUringSupported() {
+#ifdef FILEREADER_HAVE_IO_URING
+    // 5.6+ has all three
+    static const bool supported =
+        IoUringRing::supports({unsigned(IORING_OP_OPENAT), unsigned(IORING_OP_READ), unsigned(IORING_OP_CLOSE)});
+    return supported;
+#else
+    return false;
+#endif
+}
+
+BatchFileReader::Stats BatchFileReader::readAll(const std::vector<std::string>& paths, const FileCallback& onFile,
+                                                const ErrorCallback& onError) {
+    Stats stats;
+    if (backend_ == Backend::IoUring && readWithIoUring(paths, onFile, onError, stats)) {
+        stats.backend = Backend::IoUring;
+        return stats;
+    }
+    stats.backend = Backend::ThreadPool;
+    readWithPool(paths, onFile, onError, stats);
+    return stats;
+}
+
+bool BatchFileReader::readWithIoUring(const std::vector<std::string>& paths, const FileCallback& onFile,
+                                      const ErrorCallback& onError, Stats& stats) {
+#ifdef FILEREADER_HAVE_IO_URING
+    // Each slot walks one file through OPENAT -> READ... -> CLOSE. The
+    // close is fire-and-forget, so the slot starts its next file at once.
+    enum Op : uint64_t { Open = 0, Read = 1, Close = 2 };
+    struct Slot {
+        size_t index = 0;
+        int fd = -1;
+        size_t size = 0;
+        ReadBuffer buffer;
+    };
+
+    const size_t depth = std::min(options_.queueDepth, std::max<size_t>(paths.size(), 1));
+    // Declared before the ring so it is destroyed after it: if the loop
+    // throws with reads in flight, their buffers outlive the ring
+    std::vector<Slot> slots(depth);
+    // Room for one operation per slot plus one pending close per slot
+    IoUringRing ring(static_cast<unsigned>(std::bit_ceil(depth * 2)));
+    if (!ring.valid()) return false;
+
+    size_t next = 0;
+    size_t inflight = 0;
+    std::exception_ptr error;
+
+    auto userData = [](size_t slot, Op op) { return (static_cast<uint64_t>(slot) << 2) | op; };
+    auto sqe = [&]() {
+        io_uring_sqe* entry = ring.nextSqe();
+        while (!entry) {
+            ring.submitAndWait(0);
+            entry = ring.nextSqe();
+        }
+        ++inflight;
+        return entry;
+    };
+    auto startFile = [&](size_t s) {
+        if (next >= paths.size() || error) return;
+        Slot& slot = slots[s];
+        slot.index = next++;
+        slot.size = 0;
+        io_uring_sqe* entry = sqe();
+        entry->opcode = IORING_OP_OPENAT;
+        entry->fd = AT_FDCWD;
+        entry->addr = reinterpret_cast<uint64_t>(paths[slot.index].c_str());
+        entry->open_flags = O_RDONLY | O_CLOEXEC;
+        entry->user_data = userData(s, Open);
+    };
+    auto startRead = [&](size_t s) {
+        Slot& slot = slots[s];
+        if (slot.size == slot.buffer.capacity) {
+            size_t grown = slot.buffer.capacity ? slot.buffer.capacity * 2 : kInitialBuffer;
+            slot.buffer.reserve(std::min(grown, options_.maxFileSize + 1), slot.size);
+        }
+        io_uring_sqe* entry = sqe();
+        entry->opcode = IORING_OP_READ;
+        entry->fd = slot.fd;
+        entry->addr = reinterpret_cast<uint64_t>(slot.buffer.data.get() + slot.size);
+        entry->len = static_cast<uint32_t>(std::min<size_t>(slot.buffer.capacity - slot.size, 1u << 30));
+        entry->off = slot.size;
+        entry->user_data = userData(s, Read);
+    };
+    auto closeFile = [&](size_t s) {
+        io_uring_sqe* entry = sqe();
+        entry->opcode = IORING_OP_CLOSE;
+        entry->fd = slots[s].fd;
+        entry->user_data = userData(s, Close);
+        slots[s].fd = -1;
+    };
+    auto report = [&](size_t s, int err) {
+        Slot& slot = slots[s];
+        if (error) return;
+        try {
+            if (err) {
+                ++stats.failed;
+                if (onError) onError(slot.index, err);
+            } else {
+                ++stats.files;
+                stats.bytes += slot.size;
+                if (onFile) onFile(slot.index, std::string_view(slot.buffer.data.get(), slot.size));
+            }
+        } catch (...) {
+            error = std::current_exception();  // Stop starting files; drain what is in flight
+        }
+    };
+
+    for (size_t s = 0; s < depth; ++s) startFile(s);
+    while (inflight > 0) {
+        if (ring.submitAndWait(1) < 0 && errno != EBUSY && errno != EAGAIN) {
+            // The ring is unusable; what it had in flight cannot be trusted
+            throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+        }
+        ring.drain([&](const io_uring_cqe& cqe) {
+            --inflight;
+            size_t s = static_cast<size_t>(cqe.user_data >> 2);
+            Slot& slot = slots[s];
+            switch (static_cast<Op>(cqe.user_data & 3)) {
+            case Open:
+                if (cqe.res < 0) {
+                    report(s, -cqe.res);
+                    startFile(s);
+                } else {
+                    slot.fd = cqe.res;
+                    startRead(s);
+                }
+                break;
+            case Read:
+                if (cqe.res < 0) {
+                    report(s, -cqe.res);
+                } else {
+                    size_t requested = std::min<size_t>(slot.buffer.capacity - slot.size, 1u << 30);
+                    slot.size += static_cast<size_t>(cqe.res);
+                    // A short read of a regular file is its end
+                    if (cqe.res > 0 && static_cast<size_t>(cqe.res) == requested) {
+                        if (slot.size <= options_.maxFileSize) {
+                            startRead(s);
+                            break;
+                        }
+                        report(s, EFBIG);
+                    } else {
+                        report(s, 0);
+                    }
+                }
+                closeFile(s);
+                startFile(s);
+                break;
+            case Close:
+                break;
+            }
+        });
+    }
+    if (error) std::rethrow_exception(error);
+    return true;
+#else
+    (void)paths;
+    (void)onFile;
+    (void)onError;
+    (void)stats;
+    return false;
+#endif
+}
+
+void BatchFileReader::readWithPool(const std::vector<std::string>& paths, const FileCallback& onFile,
+                                   const ErrorCallback& onError, Stats& stats) {
+    if (!pool_) pool_ = std::make_unique<WorkStealingPool>(options_.threads);
+
+    std::atomic<size_t> files{0}, failed{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<bool> stop{false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    // A few dozen files per task keeps the queue small for huge batches
+    constexpr size_t kFilesPerTask = 32;
+    for (size_t begin = 0; begin < paths.size(); begin += kFilesPerTask) {
+        pool_->submit([&, begin] {
+            thread_local ReadBuffer buffer;
+            size_t end = std::min(paths.size(), begin + kFilesPerTask);
+            for (size_t i = begin; i < end && !stop.load(std::memory_order_relaxed); ++i) {
+                size_t size = 0;
+                int err = readWholeFile(paths[i], buffer, options_.maxFileSize, size);
+                try {
+                    if (err) {
+                        failed.fetch_add(1, std::memory_order_relaxed);
+                        if (onError) onError(i, err);
+                    } else {
+                        files.fetch_add(1, std::memory_order_relaxed);
+                        bytes.fetch_add(size, std::memory_order_relaxed);
+                        if (onFile) onFile(i, std::string_view(buffer.data.get(), size));
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                    stop = true;
+                }
+            }
+        });
+    }
+    pool_->wait();
+
+    stats.files = files;
+    stats.failed = failed;
+    stats.bytes = bytes;
+    if (error) std::rethrow_exception(error);
+}
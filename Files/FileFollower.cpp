@@ -0,0 +1,233 @@
+#include "FileFollower.h"
+#include "LineScanner.h"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FILEREADER_HAVE_FOLLOW 1
+#endif
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#define FILEREADER_HAVE_INOTIFY 1
+#endif
+
+namespace {
+
+constexpr size_t kReadChunk = 64 * 1024;
+constexpr size_t kLineBatch = 512;
+
+} // namespace
+
+FileFollower::FileFollower(const std::string& filename) : FileFollower(filename, Options{}) {}
+
+FileFollower::FileFollower(const std::string& filename, Options options)
+    : filename_(filename), options_(options), buffer_(kReadChunk) {
+#ifdef FILEREADER_HAVE_FOLLOW
+    if (::pipe(wakePipe_) == 0) {
+        for (int fd : wakePipe_) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    } else {
+        wakePipe_[0] = wakePipe_[1] = -1;
+    }
+#endif
+#ifdef FILEREADER_HAVE_INOTIFY
+    // The directory watch sees the file being created or renamed into
+    // place; the file watch (added on open) sees appends and truncation
+    inotifyFd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd_ >= 0) {
+        std::string directory = std::filesystem::path(filename_).parent_path().string();
+        if (directory.empty()) directory = ".";
+        if (::inotify_add_watch(inotifyFd_, directory.c_str(), IN_CREATE | IN_MOVED_TO) < 0) {
+            ::close(inotifyFd_);
+            inotifyFd_ = -1;
+        }
+    }
+#endif
+    openFile(true);
+}
+
+FileFollower::~FileFollower() {
+    closeFile();
+#ifdef FILEREADER_HAVE_FOLLOW
+    if (inotifyFd_ >= 0) ::close(inotifyFd_);
+    for (int fd : wakePipe_) {
+        if (fd >= 0) ::close(fd);
+    }
+#endif
+}
+
+bool FileFollower::openFile(bool initial) {
+#ifdef FILEREADER_HAVE_FOLLOW
+    fd_ = ::open(filename_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) return false;
+    struct stat st {};
+    if (::fstat(fd_, &st) != 0) {
+        closeFile();
+        return false;
+    }
+    device_ = static_cast<uint64_t>(st.st_dev);
+    inode_ = static_cast<uint64_t>(st.st_ino);
+    carry_ = 0;
+
+    // Only the file present at construction honours the start options; a
+    // rotated-in or newly created file is read from its beginning
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+    offset_ = 0;
+    if (initial) offset_ = options_.startAtEnd ? size : (options_.startOffset <= size ? options_.startOffset : 0);
+    watchFile();
+    return true;
+#else
+    (void)initial;
+    return false;
+#endif
+}
+
+void FileFollower::closeFile() {
+#ifdef FILEREADER_HAVE_FOLLOW
+    if (fd_ >= 0) ::close(fd_);
+#endif
+    fd_ = -1;
+}
+
+void FileFollower::watchFile() {
+#ifdef FILEREADER_HAVE_INOTIFY
+    if (inotifyFd_ < 0) return;
+    if (fileWatch_ >= 0) ::inotify_rm_watch(inotifyFd_, fileWatch_);  // Fails harmlessly if already gone
+    fileWatch_ = ::inotify_add_watch(inotifyFd_, filename_.c_str(),
+                                     IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+#endif
+}
+
+size_t FileFollower::emit(const LineCallback& onLine, bool flush) {
+    std::string_view pending(buffer_.data(), carry_);
+    size_t lastEnd = pending.rfind('\n');
+    size_t lines = 0;
+    if (lastEnd != std::string_view::npos) {
+        LineScanner scanner(pending.substr(0, lastEnd + 1), false);  // getline semantics
+        LineSpan spans[kLineBatch];
+        while (size_t n = scanner.nextBatch(spans, kLineBatch)) {
+            for (size_t i = 0; i < n; ++i) onLine(scanner.line(spans[i]));
+            lines += n;
+        }
+        carry_ = pending.size() - lastEnd - 1;
+        std::memmove(buffer_.data(), buffer_.data() + lastEnd + 1, carry_);
+    }
+    if (flush && carry_ > 0) {
+        onLine(std::string_view(buffer_.data(), carry_));
+        carry_ = 0;
+        ++lines;
+    }
+    stats_.lines += lines;
+    return lines;
+}
+
+size_t FileFollower::readAppended(const LineCallback& onLine) {
+#ifdef FILEREADER_HAVE_FOLLOW
+    struct stat st {};
+    if (::fstat(fd_, &st) == 0 && static_cast<uint64_t>(st.st_size) < offset_) {
+        // Truncated in place: what we held back belongs to the old contents
+        offset_ = 0;
+        carry_ = 0;
+        ++stats_.truncations;
+    }
+
+    size_t lines = 0;
+    for (;;) {
+        // Grows only while a single line is longer than the chunk
+        if (buffer_.size() - carry_ < kReadChunk / 2) buffer_.resize(buffer_.size() * 2);
+        ssize_t n = ::pread(fd_, buffer_.data() + carry_, buffer_.size() - carry_, static_cast<off_t>(offset_));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        offset_ += static_cast<uint64_t>(n);
+        stats_.bytes += static_cast<uint64_t>(n);
+        carry_ += static_cast<size_t>(n);
+        lines += emit(onLine, false);
+    }
+    return lines;
+#else
+    (void)onLine;
+    return 0;
+#endif
+}
+
+size_t FileFollower::poll(const LineCallback& onLine) {
+#ifdef FILEREADER_HAVE_FOLLOW
+    if (fd_ < 0 && !openFile(false)) return 0;
+    size_t lines = readAppended(onLine);
+
+    // Rotation: the name now refers to another file. Finish the old one
+    // (including an unterminated last line) and switch.
+    struct stat st {};
+    if (::stat(filename_.c_str(), &st) == 0 &&
+        (static_cast<uint64_t>(st.st_ino) != inode_ || static_cast<uint64_t>(st.st_dev) != device_)) {
+        lines += readAppended(onLine);
+        lines += emit(onLine, true);
+        closeFile();
+        ++stats_.rotations;
+        if (openFile(false)) lines += readAppended(onLine);
+    }
+    return lines;
+#else
+    (void)onLine;
+    return 0;
+#endif
+}
+
+bool FileFollower::waitForChange() {
+#ifdef FILEREADER_HAVE_FOLLOW
+    pollfd fds[2] = {{wakePipe_[0], POLLIN, 0}, {inotifyFd_, POLLIN, 0}};
+    nfds_t count = inotifyFd_ >= 0 ? 2 : 1;
+    int rc = ::poll(fds, count, inotifyFd_ >= 0 ? -1 : options_.pollInterval);
+    ++stats_.wakeups;
+    if (rc < 0) return errno == EINTR;
+
+#ifdef FILEREADER_HAVE_INOTIFY
+    if (count == 2 && (fds[1].revents & POLLIN)) {
+        // The events only mean "look again"; poll() re-checks the file itself
+        alignas(inotify_event) char events[4096];
+        while (::read(inotifyFd_, events, sizeof(events)) > 0) {
+        }
+    }
+#endif
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FileFollower::run(const LineCallback& onLine) {
+#ifdef FILEREADER_HAVE_FOLLOW
+    while (!stopped_.load(std::memory_order_acquire)) {
+        poll(onLine);
+        if (stopped_.load(std::memory_order_acquire) || !waitForChange()) break;
+    }
+    // Consume the wake-up so a later run() sleeps again
+    char drained[64];
+    while (wakePipe_[0] >= 0 && ::read(wakePipe_[0], drained, sizeof(drained)) > 0) {
+    }
+    stopped_.store(false, std::memory_order_release);
+    return true;
+#else
+    (void)onLine;
+    return false;
+#endif
+}
+
+void FileFollower::stop() {
+    stopped_.store(true, std::memory_order_release);
+#ifdef FILEREADER_HAVE_FOLLOW
+    if (wakePipe_[1] >= 0) {
+        char wake = 1;
+        [[maybe_unused]] ssize_t n = ::write(wakePipe_[1], &wake, 1);
+    }
+#endif
+}
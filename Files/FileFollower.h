@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Follow mode for a growing file (tail -F). Only bytes appended since the
+// last read are read, from a remembered offset, rather than rescanning the
+// whole file; complete lines go to a callback, split like
+// FileReader::forEachLine. On Linux the follower sleeps in inotify between
+// appends, so an idle file costs no CPU; elsewhere it re-checks every
+// pollInterval milliseconds.
+//
+// Rotation (the name now refers to another inode) drains the old file and
+// continues from the start of the new one. Truncation (size below the
+// offset, e.g. copytruncate) restarts at offset 0.
+class FileFollower {
+public:
+    // Receives one line (without the '\n'); the view is only valid during the call
+    using LineCallback = std::function<void(std::string_view)>;
+
+    struct Options {
+        bool startAtEnd = false;   // Skip what the file already holds
+        uint64_t startOffset = 0;  // Resume point (e.g. a saved offset()); ignored with startAtEnd
+        int pollInterval = 250;    // Milliseconds between checks without inotify
+    };
+
+    struct Stats {
+        size_t lines = 0;
+        uint64_t bytes = 0;
+        size_t wakeups = 0;
+        size_t truncations = 0;
+        size_t rotations = 0;
+    };
+
+    explicit FileFollower(const std::string& filename);
+    FileFollower(const std::string& filename, Options options);
+    ~FileFollower();
+
+    FileFollower(const FileFollower&) = delete;
+    FileFollower& operator=(const FileFollower&) = delete;
+
+    // Delivers every complete line appended since the last call without
+    // blocking; returns how many. A missing file is not an error: it is
+    // picked up once it appears.
+    size_t poll(const LineCallback& onLine);
+
+    // poll() in a loop, sleeping until the file changes, until stop().
+    // Returns false if follow mode is not supported on this platform.
+    bool run(const LineCallback& onLine);
+
+    // Makes run() return after its current poll; safe from any thread
+    void stop();
+
+    // Byte offset of the first line not yet delivered (a partial last line
+    // is held back until its '\n' arrives)
+    uint64_t offset() const { return offset_ - carry_; }
+    bool usingInotify() const { return inotifyFd_ >= 0; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    bool openFile(bool initial);
+    void closeFile();
+    size_t readAppended(const LineCallback& onLine);
+    size_t emit(const LineCallback& onLine, bool flush);
+    void watchFile();
+    bool waitForChange();
+
+    std::string filename_;
+    Options options_;
+    Stats stats_;
+
+    int fd_ = -1;
+    uint64_t device_ = 0;
+    uint64_t inode_ = 0;
+    uint64_t offset_ = 0;          // Read position in the current file
+    std::vector<char> buffer_;     // Carried partial line followed by fresh bytes
+    size_t carry_ = 0;
+
+    int inotifyFd_ = -1;
+    int fileWatch_ = -1;
+    int wakePipe_[2] = {-1, -1};
+    std::atomic<bool> stopped_{false};
+};
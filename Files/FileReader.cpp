@@ -1,13 +1,163 @@
 #include "FileReader.h"
+#include "IoLoop.h"
+#include "LineIndex.h"
+#include "LineScanner.h"
+#include "MappedFile.h"
+#include "StreamDecompressor.h"
+#include "../Logging/AsyncLogger.h"
+#include "../Logging/Trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FILEREADER_HAVE_POSIX_IO 1
+#endif
 
 using namespace std;
 
+namespace {
+
+constexpr size_t kStreamChunk = 64 * 1024;
+constexpr size_t kLineBatch = 512;
+constexpr size_t kAsyncLineBatch = 64;  // Spans live in the coroutine frame
+
+// Emits every complete line in `buffer`; returns the length of the unterminated tail
+size_t emitLines(string_view buffer, const FileReader::LineCallback& onLine) {
+    size_t lastEnd = buffer.rfind('\n');
+    if (lastEnd == string_view::npos) return buffer.size();
+
+    LineScanner scanner(buffer.substr(0, lastEnd + 1), false);  // getline semantics
+    LineSpan spans[kLineBatch];
+    while (size_t n = scanner.nextBatch(spans, kLineBatch)) {
+        for (size_t i = 0; i < n; ++i) onLine(scanner.line(spans[i]));
+        TRACE_COUNT(LinesProcessed, n);
+    }
+    return buffer.size() - lastEnd - 1;
+}
+
+// Lines of a decompressed stream: complete lines are views into each chunk,
+// only a line spanning two chunks is copied
+void forEachDecompressedLine(const function<void(const StreamDecompressor::ChunkCallback&)>& decompress,
+                             const FileReader::LineCallback& onLine) {
+    string carry;
+    decompress([&](string_view chunk) {
+        if (!carry.empty()) {
+            size_t end = chunk.find('\n');
+            if (end == string_view::npos) {
+                carry.append(chunk);
+                return;
+            }
+            carry.append(chunk.substr(0, end));
+            onLine(carry);
+            TRACE_COUNT(LinesProcessed, 1);
+            carry.clear();
+            chunk.remove_prefix(end + 1);
+        }
+        size_t tail = emitLines(chunk, onLine);
+        carry.assign(chunk.substr(chunk.size() - tail));
+    });
+    if (!carry.empty()) {
+        onLine(carry);
+        TRACE_COUNT(LinesProcessed, 1);
+    }
+}
+
+#ifdef FILEREADER_HAVE_POSIX_IO
+struct FdCloser {
+    int fd;
+    ~FdCloser() { ::close(fd); }
+};
+#endif
+
+// Regular files are read at explicit offsets and stop at their size, so a
+// small file costs one read; pipes and devices read at the file position
+// until end of file. The open itself is synchronous.
+AsyncGenerator<string_view> chunksOf(IoLoop& loop, string path, size_t chunkBytes) {
+#ifdef FILEREADER_HAVE_POSIX_IO
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw system_error(errno, system_category(), path);
+    FdCloser closer{fd};
+    struct stat st {};
+    bool regular = ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+
+    chunkBytes = max<size_t>(chunkBytes, 1);
+    auto buffer = make_unique_for_overwrite<char[]>(chunkBytes);
+    int64_t offset = 0;
+    for (;;) {
+        int64_t n = co_await loop.read(fd, buffer.get(), chunkBytes, regular ? offset : -1);
+        if (n < 0) throw system_error(static_cast<int>(-n), system_category(), path);
+        if (n == 0) break;
+        TRACE_COUNT(BytesRead, n);
+        offset += n;
+        co_yield string_view(buffer.get(), static_cast<size_t>(n));
+        if (regular && offset >= st.st_size) break;
+    }
+#else
+    (void)loop;
+    (void)chunkBytes;
+    throw system_error(make_error_code(errc::function_not_supported), path);
+    co_return;
+#endif
+}
+
+// Same splitting as forEachDecompressedLine, yielding instead of calling back
+AsyncGenerator<string_view> linesOf(IoLoop& loop, string path, size_t chunkBytes) {
+    AsyncGenerator<string_view> chunks = chunksOf(loop, move(path), chunkBytes);
+    string carry;
+    LineSpan spans[kAsyncLineBatch];
+    while (optional<string_view> next = co_await chunks.next()) {
+        string_view chunk = *next;
+        if (!carry.empty()) {
+            size_t end = chunk.find('\n');
+            if (end == string_view::npos) {
+                carry.append(chunk);
+                continue;
+            }
+            carry.append(chunk.substr(0, end));
+            TRACE_COUNT(LinesProcessed, 1);
+            co_yield string_view(carry);
+            carry.clear();
+            chunk.remove_prefix(end + 1);
+        }
+        size_t lastEnd = chunk.rfind('\n');
+        if (lastEnd != string_view::npos) {
+            LineScanner scanner(chunk.substr(0, lastEnd + 1), false);  // getline semantics
+            while (size_t n = scanner.nextBatch(spans, kAsyncLineBatch)) {
+                TRACE_COUNT(LinesProcessed, n);
+                for (size_t i = 0; i < n; ++i) co_yield scanner.line(spans[i]);
+            }
+            chunk.remove_prefix(lastEnd + 1);
+        }
+        carry.assign(chunk);
+    }
+    if (!carry.empty()) {
+        TRACE_COUNT(LinesProcessed, 1);
+        co_yield string_view(carry);
+    }
+}
+
+Task printLines(AsyncGenerator<string_view> lines) {
+    while (optional<string_view> line = co_await lines.next()) cout << *line << '\n';
+}
+
+} // namespace
+
 FileReader::FileReader(const string& filename) : filename(filename) {
 
 }
 
 // Old-style file reading
 void FileReader::readFileOldStyle() {
+    TRACE_SCOPE("FileReader::readFileOldStyle");
     ifstream file(filename); // Modern C++ - no c_str() needed
     if (!file.is_open()) {
         cerr << "Failed to open file (old style).\n";
@@ -17,6 +167,8 @@ void FileReader::readFileOldStyle() {
     string line;
     while (getline(file, line)) {
         cout << line << '\n';
+        TRACE_COUNT(LinesProcessed, 1);
+        TRACE_COUNT(BytesRead, line.size() + 1);
     }
 
     file.close(); // Explicit close
@@ -24,6 +176,7 @@ void FileReader::readFileOldStyle() {
 
 // Modern-style file reading
 void FileReader::readFileModernStyle() {
+    TRACE_SCOPE("FileReader::readFileModernStyle");
     ifstream file(filename); // Modern C++ - no c_str() needed
     if (!file) {
         cerr << "Failed to open file (modern style).\n";
@@ -32,6 +185,152 @@ void FileReader::readFileModernStyle() {
 
     for (string line; getline(file, line); ) {
         cout << line << '\n';
+        TRACE_COUNT(LinesProcessed, 1);
+        TRACE_COUNT(BytesRead, line.size() + 1);
     }
 }
 
+// Zero-copy file reading
+void FileReader::readFileZeroCopy() {
+    TRACE_SCOPE("FileReader::readFileZeroCopy");
+    // Lines go through the async logger: no per-line stream locking here
+    auto& log = logging::AsyncLogger::console();
+    bool ok = forEachLine([&](string_view line) {
+        log.info("{}", line);
+    });
+    log.flush();
+    if (!ok) {
+        cerr << "Failed to open file (zero-copy).\n";
+    }
+}
+
+// Coroutine file reading
+void FileReader::readFileAsync() {
+    TRACE_SCOPE("FileReader::readFileAsync");
+    IoLoop loop;
+    loop.spawn(printLines(readLinesAsync(loop)));
+    try {
+        loop.run();
+    } catch (const system_error& e) {
+        cerr << "Failed to read file (async): " << e.what() << '\n';
+    }
+}
+
+AsyncGenerator<string_view> FileReader::readChunksAsync(IoLoop& loop, size_t chunkBytes) const {
+    return chunksOf(loop, filename, chunkBytes);
+}
+
+AsyncGenerator<string_view> FileReader::readLinesAsync(IoLoop& loop, size_t chunkBytes) const {
+    return linesOf(loop, filename, chunkBytes);
+}
+
+bool FileReader::forEachLine(const LineCallback& onLine) {
+    TRACE_SCOPE("FileReader::forEachLine");
+    MappedFile mapped(filename);
+    if (mapped.valid()) {
+        TRACE_COUNT(BytesRead, mapped.size());
+        Compression format = StreamDecompressor::detect(mapped.view());
+        if (format != Compression::None) {
+            try {
+                forEachDecompressedLine([&](const StreamDecompressor::ChunkCallback& onChunk) {
+                    StreamDecompressor().decompress(mapped.view(), format, onChunk);
+                }, onLine);
+            } catch (const DecompressError&) {
+                return false;
+            }
+            return true;
+        }
+        size_t tail = emitLines(mapped.view(), onLine);
+        if (tail > 0) {
+            onLine(mapped.view().substr(mapped.size() - tail));
+            TRACE_COUNT(LinesProcessed, 1);
+        }
+        return true;
+    }
+
+    // Streaming fallback: pipes, devices, empty files
+    ifstream file(filename, ios::binary);
+    if (!file) return false;
+
+    // Buffer holds the carried-over partial line followed by fresh input;
+    // it only grows when a single line is longer than the chunk.
+    vector<char> buffer(kStreamChunk);
+    size_t carry = 0;
+    bool first = true;
+    while (file) {
+        if (buffer.size() - carry < kStreamChunk / 2) buffer.resize(buffer.size() * 2);
+        file.read(buffer.data() + carry, static_cast<streamsize>(buffer.size() - carry));
+        size_t filled = carry + static_cast<size_t>(file.gcount());
+        if (filled == carry) break;
+        TRACE_COUNT(BytesRead, filled - carry);
+
+        // Compressed data arriving through a pipe: the first read holds the magic
+        if (first) {
+            first = false;
+            Compression format = StreamDecompressor::detect(string_view(buffer.data(), filled));
+            if (format != Compression::None) {
+                try {
+                    forEachDecompressedLine([&](const StreamDecompressor::ChunkCallback& onChunk) {
+                        StreamDecompressor().decompress(file, string_view(buffer.data(), filled), format, onChunk);
+                    }, onLine);
+                } catch (const DecompressError&) {
+                    return false;
+                }
+                return true;
+            }
+        }
+
+        carry = emitLines(string_view(buffer.data(), filled), onLine);
+        memmove(buffer.data(), buffer.data() + filled - carry, carry);
+    }
+    if (carry > 0) {
+        onLine(string_view(buffer.data(), carry));
+        TRACE_COUNT(LinesProcessed, 1);
+    }
+    return true;
+}
+
+bool FileReader::forEachLineInRange(size_t first, size_t count, const LineCallback& onLine, bool buildIndex) {
+    TRACE_SCOPE("FileReader::forEachLineInRange");
+    LineIndex index(filename);
+    if (buildIndex && !index.upToDate() && LineIndex::build(filename)) index = LineIndex(filename);
+    if (index.upToDate()) {
+        if (first >= index.lineCount()) return true;
+        count = min(count, index.lineCount() - first);
+        string_view range = index.lines(first, count);
+        TRACE_COUNT(BytesRead, range.size());
+        // The scanner drops an empty last line (the range then ends in
+        // '\n'), so count what it delivered
+        size_t delivered = 0;
+        size_t tail = emitLines(range, [&](string_view line) {
+            onLine(line);
+            ++delivered;
+        });
+        if (delivered < count) {
+            onLine(range.substr(range.size() - tail));
+            TRACE_COUNT(LinesProcessed, 1);
+        }
+        return true;
+    }
+
+    size_t n = 0;
+    return forEachLine([&](string_view line) {
+        if (n >= first && n - first < count) onLine(line);
+        ++n;
+    });
+}
+
+size_t FileReader::countLines() {
+    TRACE_SCOPE("FileReader::countLines");
+    MappedFile mapped(filename);
+    if (mapped.valid() && StreamDecompressor::detect(mapped.view()) == Compression::None) {
+        size_t lines = LineScanner::countLines(mapped.view());
+        TRACE_COUNT(BytesRead, mapped.size());
+        TRACE_COUNT(LinesProcessed, lines);
+        return lines;
+    }
+
+    size_t lines = 0;
+    forEachLine([&](string_view) { ++lines; });
+    return lines;
+}
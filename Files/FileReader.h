@@ -1,19 +1,63 @@
 #pragma once
 #include <iostream>
 #include <fstream>
+#include <functional>
 #include <string>
+#include <string_view>
+
+#include "AsyncGenerator.h"
 
 using namespace std;
 
+class IoLoop;
+
 class FileReader {
 
 private:
     string filename;
 public:
+    // Receives one line (without the '\n'); the view is only valid during the call
+    using LineCallback = function<void(string_view)>;
 
     FileReader(const string& filename);
     // Old-style file reading
     void readFileOldStyle();
     // Modern-style file reading
     void readFileModernStyle();
-};
\ No newline at end of file
+    // Zero-copy file reading (prints like the styles above)
+    void readFileZeroCopy();
+    // Coroutine reading on a private IoLoop (prints like the styles above)
+    void readFileAsync();
+
+    // Zero-copy line iteration: regular files are mmapped and lines are views
+    // into the mapping; pipes and other non-regular files are streamed through
+    // a fixed buffer. Splits exactly like getline. gzip and zstd input
+    // (detected by magic bytes) is decompressed on a worker thread while the
+    // lines are delivered. Returns false if the file cannot be opened or its
+    // compressed data is corrupt (lines before the damage were delivered).
+    bool forEachLine(const LineCallback& onLine);
+
+    // Lines [first, first + count) (0-based). With an up-to-date LineIndex
+    // sidecar the lines before them are not read; otherwise this skips
+    // through forEachLine. buildIndex creates or updates the sidecar on
+    // demand (writing "<file>.lidx" next to the file; only appended bytes
+    // are scanned when the file grew); files that cannot be indexed
+    // (compressed, not regular, unwritable directory) still fall back.
+    // Returns false if the file cannot be opened.
+    bool forEachLineInRange(size_t first, size_t count, const LineCallback& onLine, bool buildIndex = false);
+
+    // Coroutine reading on an IoLoop, so one thread can read thousands of
+    // files at once (see IoLoop). The generators are consumed from a Task on
+    // that loop; each view stays valid until the following next(). Chunks
+    // are raw reads of up to chunkBytes; lines split like forEachLine, with
+    // only a line spanning two chunks copied. Input is not decompressed.
+    // The file is opened by the first next(), and open or read failures are
+    // thrown from next() as std::system_error. The generators keep their own
+    // copy of the filename; the reader may go away before they finish.
+    AsyncGenerator<string_view> readChunksAsync(IoLoop& loop, size_t chunkBytes = 64 * 1024) const;
+    AsyncGenerator<string_view> readLinesAsync(IoLoop& loop, size_t chunkBytes = 64 * 1024) const;
+
+    // Line count as getline would see it, using the vectorized newline
+    // counter for mappable files (0 if the file cannot be opened)
+    size_t countLines();
+};
@@ -0,0 +1,181 @@
+#include "IoLoop.h"
+
+#include "IoUringRing.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define FILEREADER_HAVE_POSIX_IO 1
+#endif
+
+#ifndef FILEREADER_HAVE_IO_URING
+class IoUringRing {};
+#endif
+
+IoLoop::IoLoop() : IoLoop(Options{}) {}
+
+IoLoop::IoLoop(Options options) : options_(options) {
+    options_.queueDepth = std::clamp<size_t>(options_.queueDepth, 1, 4096);
+    backend_ = options_.backend;
+    if (backend_ == Backend::Auto) backend_ = ioUringSupported() ? Backend::IoUring : Backend::Inline;
+#ifdef FILEREADER_HAVE_IO_URING
+    if (backend_ == Backend::IoUring) {
+        ring_ = std::make_unique<IoUringRing>(static_cast<unsigned>(options_.queueDepth));
+        if (!ring_->valid()) ring_.reset();
+    }
+#endif
+    if (!ring_) backend_ = Backend::Inline;
+    stats_.backend = backend_;
+}
+
+IoLoop::~IoLoop() {
+    // Nothing resumes from here on; destroying a task may still wait in
+    // abandon() for reads the kernel owns
+    ready_.clear();
+    while (!tasks_.empty()) {
+        Task::Handle task = tasks_.back();
+        tasks_.pop_back();
+        task.destroy();
+    }
+}
+
+const char* IoLoop::backendName(Backend backend) {
+    switch (backend) {
+        case Backend::Auto: return "auto";
+        case Backend::IoUring: return "io_uring";
+        case Backend::Inline: return "inline";
+    }
+    return "?";
+}
+
+bool IoLoop::ioUringSupported() {
+#ifdef FILEREADER_HAVE_IO_URING
+    // READ is 5.6+
+    static const bool supported = IoUringRing::supports({unsigned(IORING_OP_READ)});
+    return supported;
+#else
+    return false;
+#endif
+}
+
+IoLoop::Stats IoLoop::stats() const {
+    return stats_;
+}
+
+void IoLoop::spawn(Task task) {
+    Task::Handle handle = std::exchange(task.handle_, {});
+    handle.promise().loop = this;
+    handle.promise().slot = tasks_.size();
+    tasks_.push_back(handle);
+    ready_.push_back(handle);
+}
+
+void IoLoop::run() {
+    for (;;) {
+        while (!ready_.empty()) {
+            std::coroutine_handle<> next = ready_.front();
+            ready_.pop_front();
+            next.resume();
+            reap();
+        }
+        if (tasks_.empty()) return;
+        if (inflight_ == 0 && backlog_.empty()) {
+            throw std::logic_error("IoLoop::run: tasks are suspended on something other than a read");
+        }
+        poll();
+    }
+}
+
+void IoLoop::finished(Task::Handle task) {
+    // Called from the task's final suspend point; destroyed by reap()
+    finished_.push_back(task);
+}
+
+void IoLoop::reap() {
+    if (finished_.empty()) return;
+    std::exception_ptr error;
+    for (Task::Handle task : finished_) {
+        size_t slot = task.promise().slot;
+        tasks_[slot] = tasks_.back();
+        tasks_[slot].promise().slot = slot;
+        tasks_.pop_back();
+        if (!error) error = task.promise().error;
+        task.destroy();
+    }
+    finished_.clear();
+    if (error) std::rethrow_exception(error);
+}
+
+void IoLoop::submit(Operation& op) {
+    if (ring_ && backlog_.empty() && inflight_ < options_.queueDepth && pushSqe(op)) return;
+    backlog_.push_back(&op);
+}
+
+bool IoLoop::pushSqe(Operation& op) {
+#ifdef FILEREADER_HAVE_IO_URING
+    io_uring_sqe* sqe = ring_->nextSqe();
+    if (!sqe) return false;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = op.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(op.buffer);
+    sqe->len = op.size;
+    sqe->off = static_cast<uint64_t>(op.offset);  // -1: file position
+    sqe->user_data = reinterpret_cast<uint64_t>(&op);
+    ++inflight_;
+    return true;
+#else
+    static_cast<void>(op);
+    return false;
+#endif
+}
+
+void IoLoop::complete(Operation& op, int64_t result) {
+    op.result = result;
+    op.done = true;
+    ++stats_.reads;
+    if (result > 0) stats_.bytes += static_cast<uint64_t>(result);
+    if (op.waiter) ready_.push_back(op.waiter);
+}
+
+void IoLoop::poll() {
+#ifdef FILEREADER_HAVE_IO_URING
+    if (ring_) {
+        while (!backlog_.empty() && inflight_ < options_.queueDepth && pushSqe(*backlog_.front())) {
+            backlog_.pop_front();
+        }
+        if (ring_->submitAndWait(1) < 0) throw std::system_error(errno, std::system_category(), "io_uring_enter");
+        ++stats_.waits;
+        ring_->drain([this](const io_uring_cqe& cqe) {
+            --inflight_;
+            complete(*reinterpret_cast<Operation*>(cqe.user_data), cqe.res);
+        });
+        return;
+    }
+#endif
+    Operation& op = *backlog_.front();
+    backlog_.pop_front();
+#ifdef FILEREADER_HAVE_POSIX_IO
+    ssize_t n;
+    do {
+        n = op.offset < 0 ? ::read(op.fd, op.buffer, op.size) : ::pread(op.fd, op.buffer, op.size, op.offset);
+    } while (n < 0 && errno == EINTR);
+    complete(op, n < 0 ? -errno : n);
+#else
+    complete(op, -ENOSYS);
+#endif
+}
+
+void IoLoop::abandon(Operation& op) {
+    op.waiter = nullptr;
+    auto queued = std::find(backlog_.begin(), backlog_.end(), &op);
+    if (queued != backlog_.end()) {
+        backlog_.erase(queued);
+        return;
+    }
+    // In the ring: the kernel may still write into the buffer
+    while (!op.done) poll();
+}
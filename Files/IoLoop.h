@@ -0,0 +1,166 @@
+#pragma once
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "AsyncGenerator.h"
+
+class IoLoop;
+class IoUringRing;
+
+// A coroutine run by an IoLoop. Tasks start suspended; IoLoop::spawn
+// takes ownership and run() drives them to completion.
+class Task {
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    // Hands the finished task back to its loop for destruction
+    struct Finished {
+        bool await_ready() noexcept { return false; }
+        void await_suspend(Handle task) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    struct promise_type {
+        IoLoop* loop = nullptr;
+        size_t slot = 0;  // Index in the loop's task list
+        std::exception_ptr error;
+
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        Finished final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&&) = delete;
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+private:
+    friend class IoLoop;
+    explicit Task(Handle handle) : handle_(handle) {}
+
+    Handle handle_;
+};
+
+// Single-threaded event loop for coroutine file I/O: one thread keeps
+// thousands of reads in flight instead of blocking a thread per file.
+// With io_uring, reads are queued as submission entries while coroutines
+// are runnable and submitted together when the loop runs dry, so one
+// io_uring_enter submits a batch and collects every completion. Without
+// it (other platforms, old kernels, Backend::Inline) reads run on the loop
+// thread in submission order, interleaved between the coroutines; such
+// reads block, so a pipe with no writer stalls the whole loop.
+//
+// Not thread-safe: spawn, read and run belong to the loop's thread.
+class IoLoop {
+public:
+    enum class Backend { Auto, IoUring, Inline };
+
+    struct Options {
+        Backend backend = Backend::Auto;
+        size_t queueDepth = 256;  // Reads in flight; more wait in a backlog
+    };
+
+    struct Stats {
+        uint64_t reads = 0;
+        uint64_t bytes = 0;
+        uint64_t waits = 0;  // io_uring_enter calls that waited (batches)
+        Backend backend = Backend::Inline;
+    };
+
+    // One pending read. Lives in the awaiting coroutine's frame.
+    struct Operation {
+        std::coroutine_handle<> waiter;
+        int fd = -1;
+        char* buffer = nullptr;
+        uint32_t size = 0;
+        int64_t offset = -1;
+        int64_t result = 0;
+        bool done = false;
+    };
+
+    class ReadAwaiter {
+    public:
+        ReadAwaiter(IoLoop& loop, Operation operation) : loop_(loop), op_(operation) {}
+        ReadAwaiter(const ReadAwaiter&) = delete;
+        ReadAwaiter& operator=(const ReadAwaiter&) = delete;
+        // A frame destroyed mid-read waits for the kernel to let go of the buffer
+        ~ReadAwaiter() {
+            if (op_.waiter && !op_.done) loop_.abandon(op_);
+        }
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> waiter) {
+            op_.waiter = waiter;
+            loop_.submit(op_);
+        }
+        // Bytes read (0 at end of file) or -errno
+        int64_t await_resume() const noexcept { return op_.result; }
+
+    private:
+        IoLoop& loop_;
+        Operation op_;
+    };
+
+    IoLoop();
+    explicit IoLoop(Options options);
+    ~IoLoop();  // Destroys unfinished tasks
+
+    IoLoop(const IoLoop&) = delete;
+    IoLoop& operator=(const IoLoop&) = delete;
+
+    void spawn(Task task);
+    // Runs until every spawned task has finished. A task's exception is
+    // rethrown as soon as that task ends; the others stay spawned.
+    void run();
+
+    // Reads up to size bytes (at most 1 GB) at offset, or at the file
+    // position when offset is -1 (pipes)
+    ReadAwaiter read(int fd, void* buffer, size_t size, int64_t offset) {
+        return ReadAwaiter(*this, Operation{{}, fd, static_cast<char*>(buffer),
+                                            static_cast<uint32_t>(size < (1u << 30) ? size : (1u << 30)), offset});
+    }
+
+    // The backend reads go through (Auto resolved)
+    Backend backend() const { return backend_; }
+    Stats stats() const;
+
+    // Kernel support for io_uring with READ
+    static bool ioUringSupported();
+    static const char* backendName(Backend backend);
+
+private:
+    friend struct Task::Finished;
+
+    void submit(Operation& op);
+    void abandon(Operation& op);
+    void finished(Task::Handle task);
+    bool pushSqe(Operation& op);
+    void complete(Operation& op, int64_t result);
+    void poll();  // Waits for at least one read to complete
+    void reap();  // Destroys finished tasks
+
+    Options options_;
+    Backend backend_;
+    std::unique_ptr<IoUringRing> ring_;
+    std::vector<Task::Handle> tasks_;
+    std::vector<Task::Handle> finished_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::deque<Operation*> backlog_;  // Not submitted yet
+    size_t inflight_ = 0;             // Submitted to the ring
+    Stats stats_;
+};
+
+inline void Task::Finished::await_suspend(Handle task) noexcept {
+    task.promise().loop->finished(task);
+}
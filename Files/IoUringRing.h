@@ -0,0 +1,144 @@
+#pragma once
+// Minimal io_uring shared by BatchFileReader and IoLoop: raw syscalls, no
+// liburing. Defines FILEREADER_HAVE_IO_URING where the kernel headers exist.
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+
+#define FILEREADER_HAVE_IO_URING 1
+
+// One submission and one completion ring, mapped once
+class IoUringRing {
+public:
+    explicit IoUringRing(unsigned entries) {
+        io_uring_params params{};
+        fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) return;
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+
+        sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        cqRing_ = single ? sqRing_
+                         : mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+        if (sqRing_ == MAP_FAILED || cqRing_ == MAP_FAILED || sqes == MAP_FAILED) {
+            if (sqes != MAP_FAILED) munmap(sqes, sqesSize_);
+            sqesSize_ = 0;
+            teardown();
+            return;
+        }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries_ = params.sq_entries;
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        valid_ = true;
+    }
+
+    ~IoUringRing() { teardown(); }
+
+    IoUringRing(const IoUringRing&) = delete;
+    IoUringRing& operator=(const IoUringRing&) = delete;
+
+    bool valid() const { return valid_; }
+    int fd() const { return fd_; }
+
+    // Whether a ring can be set up and the kernel knows every opcode
+    static bool supports(std::initializer_list<unsigned> opcodes) {
+        IoUringRing ring(4);
+        if (!ring.valid()) return false;
+        constexpr unsigned kOps = 256;
+        alignas(io_uring_probe) unsigned char storage[sizeof(io_uring_probe) + kOps * sizeof(io_uring_probe_op)]{};
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage);
+        if (syscall(__NR_io_uring_register, ring.fd(), IORING_REGISTER_PROBE, probe, kOps) < 0) return false;
+        for (unsigned op : opcodes) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+        }
+        return true;
+    }
+
+    // Next free submission entry, zeroed; nullptr when the ring is full
+    io_uring_sqe* nextSqe() {
+        unsigned head = std::atomic_ref<unsigned>(*sqHead_).load(std::memory_order_acquire);
+        if (localTail_ - head >= sqEntries_) return nullptr;
+        unsigned index = localTail_ & sqMask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray_[index] = index;
+        ++localTail_;
+        return sqe;
+    }
+
+    // Publishes queued entries and waits for at least minComplete completions
+    int submitAndWait(unsigned minComplete) {
+        std::atomic_ref<unsigned>(*sqTail_).store(localTail_, std::memory_order_release);
+        for (;;) {
+            // Everything the kernel has not consumed yet, including leftovers
+            unsigned toSubmit = localTail_ - std::atomic_ref<unsigned>(*sqHead_).load(std::memory_order_acquire);
+            long rc = syscall(__NR_io_uring_enter, fd_, toSubmit, minComplete,
+                              minComplete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (rc >= 0 || errno != EINTR) return static_cast<int>(rc);
+        }
+    }
+
+    // Calls fn(cqe) for every available completion, then frees them
+    template <typename F>
+    void drain(F&& fn) {
+        unsigned head = std::atomic_ref<unsigned>(*cqHead_).load(std::memory_order_relaxed);
+        unsigned tail = std::atomic_ref<unsigned>(*cqTail_).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            io_uring_cqe cqe = cqes_[head & cqMask_];
+            std::atomic_ref<unsigned>(*cqHead_).store(head + 1, std::memory_order_release);
+            fn(cqe);
+        }
+    }
+
+private:
+    void teardown() {
+        if (sqes_) munmap(sqes_, sqesSize_);
+        if (cqRing_ && cqRing_ != MAP_FAILED && cqRing_ != sqRing_) munmap(cqRing_, cqRingSize_);
+        if (sqRing_ && sqRing_ != MAP_FAILED) munmap(sqRing_, sqRingSize_);
+        if (fd_ >= 0) close(fd_);
+        sqes_ = nullptr;
+        cqRing_ = sqRing_ = nullptr;
+        fd_ = -1;
+        valid_ = false;
+    }
+
+    int fd_ = -1;
+    bool valid_ = false;
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    size_t sqRingSize_ = 0, cqRingSize_ = 0, sqesSize_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned *sqHead_ = nullptr, *sqTail_ = nullptr, *sqArray_ = nullptr;
+    unsigned *cqHead_ = nullptr, *cqTail_ = nullptr;
+    unsigned sqMask_ = 0, sqEntries_ = 0, cqMask_ = 0;
+    unsigned localTail_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+#endif
@@ -0,0 +1,326 @@
+#include "LineIndex.h"
+#include "LineScanner.h"
+#include "StreamDecompressor.h"
+#include "../Logging/Trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <random>
+#endif
+
+namespace {
+
+constexpr char kMagic[4] = {'L', 'I', 'D', 'X'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kOpenTail = 1;  // Flag: the last indexed line has no '\n'
+constexpr size_t kFingerprintWindow = 4096;
+constexpr size_t kScanBatch = 512;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceBytes;  // Indexed prefix of the source
+    uint64_t lines;
+    uint64_t headHash;     // First kFingerprintWindow bytes of the prefix
+    uint64_t tailHash;     // Last kFingerprintWindow bytes of the prefix
+    uint64_t deltaBytes;   // Size of the length column
+    uint64_t columnsHash;  // Checkpoints and lengths, checked before build() reuses them
+    uint32_t blockLines;
+    uint32_t flags;
+};
+static_assert(sizeof(Header) % alignof(uint64_t) == 0, "checkpoints follow the header");
+
+struct Checkpoint {
+    uint64_t source;
+    uint64_t delta;
+};
+
+uint64_t fnv1a(std::string_view bytes, uint64_t hash = 0xcbf29ce484222325ull) {
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+bool fingerprintMatches(std::string_view source, const Header& header) {
+    std::string_view prefix = source.substr(0, header.sourceBytes);
+    size_t window = std::min(prefix.size(), kFingerprintWindow);
+    return fnv1a(prefix.substr(0, window)) == header.headHash &&
+           fnv1a(prefix.substr(prefix.size() - window)) == header.tailHash;
+}
+
+// The header of a well-formed sidecar, or nullptr
+const Header* parseHeader(const MappedFile& index) {
+    if (!index.valid() || index.size() < sizeof(Header)) return nullptr;
+    const auto* header = reinterpret_cast<const Header*>(index.data());
+    if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 || header->version != kVersion ||
+        header->blockLines != LineIndex::kBlockLines) {
+        return nullptr;
+    }
+    uint64_t blocks = (header->lines + LineIndex::kBlockLines - 1) / LineIndex::kBlockLines;
+    if (blocks > index.size() / sizeof(Checkpoint) || header->deltaBytes > index.size()) return nullptr;
+    if (index.size() != sizeof(Header) + blocks * sizeof(Checkpoint) + header->deltaBytes) return nullptr;
+    return header;
+}
+
+// Everything after the header (parseHeader checked the size)
+uint64_t hashColumns(const MappedFile& index) {
+    return fnv1a(index.view().substr(sizeof(Header)));
+}
+
+// LEB128; false at the end of the column or on an overlong value
+bool readVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        unsigned char byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Writes parts to a new file next to path with a unique name, stored in
+// temp (empty if none was created)
+bool writeUnique(const std::string& path, std::string& temp, std::initializer_list<std::string_view> parts) {
+#if defined(__unix__) || defined(__APPLE__)
+    std::string name = path + ".XXXXXX";
+    int fd = ::mkstemp(name.data());
+    if (fd < 0) return false;
+    temp = name;
+    // mkstemp creates 0600; the sidecar is as readable as a plain new file
+    bool ok = ::fchmod(fd, 0644) == 0;
+    for (std::string_view part : parts) {
+        for (size_t done = 0; ok && done < part.size();) {
+            ssize_t n = ::write(fd, part.data() + done, part.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            ok = n > 0;
+            if (ok) done += static_cast<size_t>(n);
+        }
+    }
+    return ::close(fd) == 0 && ok;
+#else
+    temp = path + ".tmp" + std::to_string(std::random_device{}());
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    for (std::string_view part : parts) out.write(part.data(), static_cast<std::streamsize>(part.size()));
+    return static_cast<bool>(out.flush());
+#endif
+}
+
+// Accumulates the two columns of a new index
+struct Builder {
+    std::vector<Checkpoint> checkpoints;
+    std::vector<unsigned char> deltas;
+    uint64_t lines = 0;
+    uint64_t next = 0;  // Offset of the next line
+
+    void add(uint64_t length) {
+        if (lines % LineIndex::kBlockLines == 0) checkpoints.push_back({next, deltas.size()});
+        for (uint64_t v = length; ; v >>= 7) {
+            if (v < 0x80) {
+                deltas.push_back(static_cast<unsigned char>(v));
+                break;
+            }
+            deltas.push_back(static_cast<unsigned char>(v | 0x80));
+        }
+        ++lines;
+        next += length;
+    }
+
+    // Takes over the first `keep` lines of an existing index
+    bool restore(const MappedFile& index, const Header& header, uint64_t keep) {
+        if (keep == 0) return true;
+        uint64_t blockCount = (header.lines + LineIndex::kBlockLines - 1) / LineIndex::kBlockLines;
+        const auto* blocks = reinterpret_cast<const Checkpoint*>(index.data() + sizeof(Header));
+        const auto* column = reinterpret_cast<const unsigned char*>(blocks + blockCount);
+        uint64_t last = (keep - 1) / LineIndex::kBlockLines;
+        if (blocks[last].delta > header.deltaBytes) return false;
+
+        // Decode the kept part of the last block to find where it ends
+        const unsigned char* p = column + blocks[last].delta;
+        uint64_t offset = blocks[last].source;
+        for (uint64_t i = last * LineIndex::kBlockLines; i < keep; ++i) {
+            uint64_t length;
+            if (!readVarint(p, column + header.deltaBytes, length)) return false;
+            offset += length;
+        }
+        if (offset > header.sourceBytes) return false;
+        checkpoints.assign(blocks, blocks + last + 1);
+        deltas.assign(column, p);
+        lines = keep;
+        next = offset;
+        return true;
+    }
+
+    bool write(const std::string& path, std::string_view source, bool openTail) const {
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.sourceBytes = next;
+        header.lines = lines;
+        size_t window = std::min<size_t>(next, kFingerprintWindow);
+        header.headHash = fnv1a(source.substr(0, window));
+        header.tailHash = fnv1a(source.substr(next - window, window));
+        header.deltaBytes = deltas.size();
+        header.columnsHash = fnv1a(
+            std::string_view(reinterpret_cast<const char*>(deltas.data()), deltas.size()),
+            fnv1a(std::string_view(reinterpret_cast<const char*>(checkpoints.data()),
+                                   checkpoints.size() * sizeof(Checkpoint))));
+        header.blockLines = LineIndex::kBlockLines;
+        header.flags = openTail ? kOpenTail : 0;
+
+        // Readers of the old sidecar keep their mapping; new opens see the
+        // whole new file or the whole old one. The temporary has a unique
+        // name so concurrent builders never write into each other's file.
+        std::string temp;
+        bool written = writeUnique(path, temp, {
+            {reinterpret_cast<const char*>(&header), sizeof(header)},
+            {reinterpret_cast<const char*>(checkpoints.data()), checkpoints.size() * sizeof(Checkpoint)},
+            {reinterpret_cast<const char*>(deltas.data()), deltas.size()},
+        });
+        if (!written) {
+            if (!temp.empty()) std::remove(temp.c_str());
+            return false;
+        }
+        std::error_code error;
+        std::filesystem::rename(temp, path, error);
+        if (error) std::remove(temp.c_str());
+        return !error;
+    }
+};
+
+} // namespace
+
+std::string LineIndex::sidecarPath(const std::string& filename) {
+    return filename + ".lidx";
+}
+
+bool LineIndex::build(const std::string& filename, BuildStats* stats) {
+    return build(filename, sidecarPath(filename), stats);
+}
+
+bool LineIndex::build(const std::string& filename, const std::string& indexPath, BuildStats* stats) {
+    TRACE_SCOPE("LineIndex::build");
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filename, error)) return false;
+    MappedFile source(filename);
+    // An empty file cannot be mapped but indexes fine
+    if (!source.valid() && std::filesystem::file_size(filename, error) != 0) return false;
+    std::string_view text = source.valid() ? source.view() : std::string_view();
+    if (StreamDecompressor::detect(text) != Compression::None) return false;
+
+    Builder builder;
+    BuildStats result;
+    {
+        MappedFile old(indexPath);
+        const Header* header = parseHeader(old);
+        if (header && header->sourceBytes <= text.size() && fingerprintMatches(text, *header) &&
+            hashColumns(old) == header->columnsHash) {
+            if (header->sourceBytes == text.size()) {
+                result.lines = header->lines;
+                result.incremental = true;
+                if (stats) *stats = result;
+                return true;
+            }
+            // A final line without '\n' may have grown: rescan it
+            uint64_t keep = header->lines - ((header->flags & kOpenTail) ? 1 : 0);
+            result.incremental = builder.restore(old, *header, keep);
+            if (!result.incremental) builder = Builder();
+        }
+    }
+
+    std::string_view rest = text.substr(builder.next);
+    LineScanner scanner(rest, false);  // getline semantics
+    LineSpan spans[kScanBatch];
+    while (size_t n = scanner.nextBatch(spans, kScanBatch)) {
+        for (size_t i = 0; i < n; ++i) {
+            size_t end = spans[i].offset + spans[i].length;
+            builder.add(end < rest.size() ? spans[i].length + 1 : spans[i].length);
+        }
+    }
+    TRACE_COUNT(BytesRead, rest.size());
+    result.scannedBytes = rest.size();
+    result.lines = builder.lines;
+    if (stats) *stats = result;
+    return builder.write(indexPath, text, !text.empty() && text.back() != '\n');
+}
+
+LineIndex::LineIndex(const std::string& filename) : LineIndex(filename, sidecarPath(filename)) {}
+
+LineIndex::LineIndex(const std::string& filename, const std::string& indexPath)
+    : source_(filename, MappedFile::Access::Random), index_(indexPath, MappedFile::Access::Random) {
+    const Header* header = parseHeader(index_);
+    if (!header) return;
+    std::string_view text = source_.valid() ? source_.view() : std::string_view();
+    if (header->sourceBytes > text.size() || !fingerprintMatches(text, *header)) return;
+
+    uint64_t blocks = (header->lines + kBlockLines - 1) / kBlockLines;
+    checkpoints_ = reinterpret_cast<const uint64_t*>(index_.data() + sizeof(Header));
+    deltas_ = reinterpret_cast<const unsigned char*>(checkpoints_ + 2 * blocks);
+    // Checkpoints are trusted by locate(); the lengths are clamped there
+    for (uint64_t b = 0; b < blocks; ++b) {
+        if (checkpoints_[2 * b] > header->sourceBytes || checkpoints_[2 * b + 1] > header->deltaBytes) return;
+    }
+    deltaBytes_ = header->deltaBytes;
+    sourceSize_ = text.size();
+    indexedBytes_ = header->sourceBytes;
+    lines_ = static_cast<size_t>(header->lines);
+    valid_ = true;
+}
+
+void LineIndex::locate(size_t n, uint64_t& start, uint64_t& length) const {
+    size_t block = n / kBlockLines;
+    const unsigned char* p = deltas_ + checkpoints_[2 * block + 1];
+    const unsigned char* end = deltas_ + deltaBytes_;
+    start = checkpoints_[2 * block];
+    for (size_t i = block * kBlockLines; i < n; ++i) {
+        uint64_t skip = 0;
+        readVarint(p, end, skip);
+        start += skip;
+    }
+    length = 0;
+    readVarint(p, end, length);
+    // A damaged length column yields wrong lines, never reads outside the file
+    start = std::min(start, indexedBytes_);
+    length = std::min(length, indexedBytes_ - start);
+}
+
+std::string_view LineIndex::line(size_t n) const {
+    if (n >= lines_) throw std::out_of_range("LineIndex::line");
+    uint64_t start, length;
+    locate(n, start, length);
+    if (length > 0 && source_.data()[start + length - 1] == '\n') --length;
+    return {source_.data() + start, static_cast<size_t>(length)};
+}
+
+std::string_view LineIndex::lines(size_t first, size_t count) const {
+    if (first > lines_) throw std::out_of_range("LineIndex::lines");
+    count = std::min(count, lines_ - first);
+    if (count == 0) return {};
+    uint64_t start = offset(first);
+    uint64_t lastStart, lastLength;
+    locate(first + count - 1, lastStart, lastLength);
+    uint64_t end = std::max(lastStart + lastLength, start);
+    if (end > start && source_.data()[end - 1] == '\n') --end;
+    return {source_.data() + start, static_cast<size_t>(end - start)};
+}
+
+uint64_t LineIndex::offset(size_t n) const {
+    if (n > lines_) throw std::out_of_range("LineIndex::offset");
+    if (n == lines_) return indexedBytes_;
+    uint64_t start, length;
+    locate(n, start, length);
+    return start;
+}
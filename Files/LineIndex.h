@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "MappedFile.h"
+
+// Random access to the lines of a large file through a sidecar index
+// (by default "<file>.lidx"), so reaching line N no longer means scanning
+// everything before it.
+//
+// The sidecar is columnar: a fixed header, then one checkpoint per
+// kBlockLines lines (absolute byte offset of the block's first line and
+// where its lengths start), then every line's length (terminator included)
+// as a LEB128 varint, mostly one or two bytes per line. A lookup reads one
+// checkpoint and decodes at most kBlockLines varints, whatever the file
+// size. Values are stored in host byte order: the index is a local cache,
+// not an interchange format.
+//
+// build() only scans what was appended since the index was written (a
+// final line without '\n' is rescanned, since it may have grown). The
+// source counts as appended-to when it is no shorter than the indexed
+// prefix and the first and last 4 KB of that prefix hash the same;
+// anything else rebuilds from scratch, as does a sidecar whose checksum
+// no longer matches. Lookups skip that check to stay O(1) but never read
+// outside the mapped files. Compressed files are not indexed.
+class LineIndex {
+public:
+    static constexpr size_t kBlockLines = 64;
+
+    struct BuildStats {
+        uint64_t scannedBytes = 0;  // Source bytes read for new lines
+        size_t lines = 0;           // Lines indexed in total
+        bool incremental = false;   // Earlier entries were kept
+    };
+
+    static std::string sidecarPath(const std::string& filename);
+
+    // Creates or brings up to date the sidecar, replacing it atomically
+    // (write to a uniquely named temporary, then rename), so open readers
+    // keep a consistent old index and concurrent builds do not corrupt it. Returns false if the source is not a readable
+    // regular uncompressed file or the index cannot be written.
+    static bool build(const std::string& filename, BuildStats* stats = nullptr);
+    static bool build(const std::string& filename, const std::string& indexPath, BuildStats* stats = nullptr);
+
+    // Maps the source and its sidecar. The index is invalid when the
+    // sidecar is missing, corrupt or no longer matches the source.
+    explicit LineIndex(const std::string& filename);
+    LineIndex(const std::string& filename, const std::string& indexPath);
+
+    bool valid() const { return valid_; }
+    // False once the source has grown past what the index covers; lines
+    // appended since are not visible until build() runs again
+    bool upToDate() const { return valid_ && indexedBytes_ == sourceSize_; }
+
+    size_t lineCount() const { return lines_; }
+
+    // Line n (0-based) without its '\n', as getline returns it; a view into
+    // the mapped source. Throws std::out_of_range past lineCount().
+    std::string_view line(size_t n) const;
+    // Lines [first, first + count) as one view, '\n' between lines, none
+    // after the last; count is clamped to the end of the file
+    std::string_view lines(size_t first, size_t count) const;
+    // Byte offset of line n in the source (n == lineCount(): end of the
+    // indexed data)
+    uint64_t offset(size_t n) const;
+
+private:
+    // Start offset and length (terminator included) of line n
+    void locate(size_t n, uint64_t& start, uint64_t& length) const;
+
+    MappedFile source_;
+    MappedFile index_;
+    const uint64_t* checkpoints_ = nullptr;  // Per block: first line's offset, its length's offset
+    const unsigned char* deltas_ = nullptr;
+    uint64_t deltaBytes_ = 0;
+    uint64_t sourceSize_ = 0;
+    uint64_t indexedBytes_ = 0;
+    size_t lines_ = 0;
+    bool valid_ = false;
+};
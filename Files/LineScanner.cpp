@@ -0,0 +1,291 @@
+#include "LineScanner.h"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define LINESCANNER_X86 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LINESCANNER_NEON 1
+#endif
+
+namespace {
+
+// Kernel contract: record the offsets of '\n' in [begin, end) into `out`.
+// Kernels only start a block while at least one block's worth of room is
+// left, so they never stop mid-block; `*stop` receives where scanning ended.
+using ScanFn = size_t (*)(const char* data, size_t begin, size_t end,
+                          size_t* out, size_t capacity, size_t* stop);
+using CountFn = size_t (*)(const char* data, size_t size);
+
+struct Kernels {
+    LineScanner::Isa isa;
+    ScanFn scan;
+    CountFn count;
+};
+
+size_t scanScalarRange(const char* data, size_t begin, size_t end,
+                       size_t* out, size_t capacity, size_t* stop) {
+    size_t n = 0;
+    size_t i = begin;
+    for (; i < end && n < capacity; ++i) {
+        if (data[i] == '\n') out[n++] = i;
+    }
+    *stop = i;
+    return n;
+}
+
+size_t countScalar(const char* data, size_t size) {
+    size_t n = 0;
+    for (size_t i = 0; i < size; ++i) n += (data[i] == '\n');
+    return n;
+}
+
+// Appends the set bits of a block mask as absolute offsets
+inline size_t drainMask(uint64_t mask, size_t base, size_t* out, size_t n) {
+    while (mask) {
+        out[n++] = base + static_cast<size_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+#ifdef LINESCANNER_X86
+
+__attribute__((target("sse2")))
+size_t scanSSE2(const char* data, size_t begin, size_t end,
+                size_t* out, size_t capacity, size_t* stop) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    size_t n = 0, i = begin;
+    for (; i + 16 <= end && capacity - n >= 16; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)));
+        n = drainMask(mask, i, out, n);
+    }
+    size_t tail;
+    n += scanScalarRange(data, i, end, out + n, capacity - n, &tail);
+    *stop = tail;
+    return n;
+}
+
+__attribute__((target("sse2")))
+size_t countSSE2(const char* data, size_t size) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    size_t n = 0, i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        n += static_cast<size_t>(__builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl))));
+    }
+    return n + countScalar(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+size_t scanAVX2(const char* data, size_t begin, size_t end,
+                size_t* out, size_t capacity, size_t* stop) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    size_t n = 0, i = begin;
+    for (; i + 32 <= end && capacity - n >= 32; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl)));
+        n = drainMask(mask, i, out, n);
+    }
+    size_t tail;
+    n += scanSSE2(data, i, end, out + n, capacity - n, &tail);
+    *stop = tail;
+    return n;
+}
+
+__attribute__((target("avx2,popcnt")))
+size_t countAVX2(const char* data, size_t size) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    size_t n = 0, i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        n += static_cast<size_t>(_mm_popcnt_u32(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, nl)))));
+    }
+    return n + countSSE2(data + i, size - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+size_t scanAVX512(const char* data, size_t begin, size_t end,
+                  size_t* out, size_t capacity, size_t* stop) {
+    const __m512i nl = _mm512_set1_epi8('\n');
+    size_t n = 0, i = begin;
+    for (; i + 64 <= end && capacity - n >= 64; i += 64) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        n = drainMask(_mm512_cmpeq_epi8_mask(v, nl), i, out, n);
+    }
+    size_t tail;
+    n += scanAVX2(data, i, end, out + n, capacity - n, &tail);
+    *stop = tail;
+    return n;
+}
+
+__attribute__((target("avx512f,avx512bw,popcnt")))
+size_t countAVX512(const char* data, size_t size) {
+    const __m512i nl = _mm512_set1_epi8('\n');
+    size_t n = 0, i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m512i v = _mm512_loadu_si512(data + i);
+        n += static_cast<size_t>(_mm_popcnt_u64(_mm512_cmpeq_epi8_mask(v, nl)));
+    }
+    return n + countAVX2(data + i, size - i);
+}
+
+#endif // LINESCANNER_X86
+
+#ifdef LINESCANNER_NEON
+
+// NEON has no movemask; narrowing the compare result gives 4 bits per byte
+inline uint64_t neonMask(uint8x16_t cmp) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+}
+
+size_t scanNEON(const char* data, size_t begin, size_t end,
+                size_t* out, size_t capacity, size_t* stop) {
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    size_t n = 0, i = begin;
+    for (; i + 16 <= end && capacity - n >= 16; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint64_t mask = neonMask(vceqq_u8(v, nl)) & 0x1111111111111111ULL;
+        while (mask) {
+            out[n++] = i + static_cast<size_t>(__builtin_ctzll(mask) >> 2);
+            mask &= mask - 1;
+        }
+    }
+    size_t tail;
+    n += scanScalarRange(data, i, end, out + n, capacity - n, &tail);
+    *stop = tail;
+    return n;
+}
+
+size_t countNEON(const char* data, size_t size) {
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    size_t n = 0, i = 0;
+    for (; i + 16 <= size; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        n += vaddvq_u8(vandq_u8(vceqq_u8(v, nl), vdupq_n_u8(1)));
+    }
+    return n + countScalar(data + i, size - i);
+}
+
+#endif // LINESCANNER_NEON
+
+const Kernels kScalar{LineScanner::Isa::Scalar, scanScalarRange, countScalar};
+#ifdef LINESCANNER_X86
+const Kernels kSSE2{LineScanner::Isa::SSE2, scanSSE2, countSSE2};
+const Kernels kAVX2{LineScanner::Isa::AVX2, scanAVX2, countAVX2};
+const Kernels kAVX512{LineScanner::Isa::AVX512, scanAVX512, countAVX512};
+#endif
+#ifdef LINESCANNER_NEON
+const Kernels kNEON{LineScanner::Isa::NEON, scanNEON, countNEON};
+#endif
+
+const Kernels* kernelsFor(LineScanner::Isa isa) {
+    switch (isa) {
+        case LineScanner::Isa::Scalar: return &kScalar;
+#ifdef LINESCANNER_X86
+        case LineScanner::Isa::SSE2: return &kSSE2;
+        case LineScanner::Isa::AVX2:
+            return __builtin_cpu_supports("avx2") ? &kAVX2 : nullptr;
+        case LineScanner::Isa::AVX512:
+            return __builtin_cpu_supports("avx512bw") ? &kAVX512 : nullptr;
+#endif
+#ifdef LINESCANNER_NEON
+        case LineScanner::Isa::NEON: return &kNEON;
+#endif
+        default: return nullptr;
+    }
+}
+
+const Kernels* detectKernels() {
+    for (auto isa : {LineScanner::Isa::AVX512, LineScanner::Isa::AVX2,
+                     LineScanner::Isa::SSE2, LineScanner::Isa::NEON}) {
+        if (const Kernels* k = kernelsFor(isa)) return k;
+    }
+    return &kScalar;
+}
+
+std::atomic<const Kernels*>& activeKernels() {
+    static std::atomic<const Kernels*> active{detectKernels()};
+    return active;
+}
+
+// Offsets buffered per kernel call while filling a batch
+constexpr size_t kOffsetBlock = 256;
+
+} // namespace
+
+LineScanner::LineScanner(std::string_view buffer, bool stripCarriageReturn)
+    : buffer_(buffer), stripCR_(stripCarriageReturn), pendingTail_(!buffer.empty()) {
+}
+
+size_t LineScanner::nextBatch(LineSpan* out, size_t capacity) {
+    const Kernels* kernels = activeKernels().load(std::memory_order_relaxed);
+    const char* data = buffer_.data();
+    const size_t size = buffer_.size();
+    size_t offsets[kOffsetBlock];
+    size_t produced = 0;
+    size_t scan = pos_;
+
+    while (produced < capacity && scan < size) {
+        size_t room = capacity - produced < kOffsetBlock ? capacity - produced : kOffsetBlock;
+        size_t stop;
+        size_t found = kernels->scan(data, scan, size, offsets, room, &stop);
+        for (size_t k = 0; k < found; ++k) {
+            size_t end = offsets[k];
+            if (stripCR_ && end > pos_ && data[end - 1] == '\r') --end;
+            out[produced++] = LineSpan{pos_, end - pos_};
+            pos_ = offsets[k] + 1;
+        }
+        scan = stop;
+    }
+
+    // Unterminated final line (getline reports it, but not an empty one)
+    if (produced < capacity && scan >= size && pendingTail_) {
+        pendingTail_ = false;
+        if (pos_ < size) {
+            size_t end = size;
+            if (stripCR_ && data[end - 1] == '\r') --end;
+            out[produced++] = LineSpan{pos_, end - pos_};
+            pos_ = size;
+        }
+    }
+    return produced;
+}
+
+size_t LineScanner::countLines(std::string_view buffer) {
+    if (buffer.empty()) return 0;
+    size_t newlines = activeKernels().load(std::memory_order_relaxed)->count(buffer.data(), buffer.size());
+    return newlines + (buffer.back() != '\n');
+}
+
+LineScanner::Isa LineScanner::activeIsa() {
+    return activeKernels().load(std::memory_order_relaxed)->isa;
+}
+
+bool LineScanner::forceIsa(Isa isa) {
+    const Kernels* kernels = kernelsFor(isa);
+    if (!kernels) return false;
+    activeKernels().store(kernels, std::memory_order_relaxed);
+    return true;
+}
+
+bool LineScanner::isaSupported(Isa isa) {
+    return kernelsFor(isa) != nullptr;
+}
+
+const char* LineScanner::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE2: return "sse2";
+        case Isa::AVX2: return "avx2";
+        case Isa::AVX512: return "avx512bw";
+        case Isa::NEON: return "neon";
+    }
+    return "unknown";
+}
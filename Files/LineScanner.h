@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+// One line inside a scanned buffer: [offset, offset + length), terminator excluded
+struct LineSpan {
+    size_t offset;
+    size_t length;
+};
+
+// Vectorized line splitter over an in-memory buffer (e.g. a MappedFile).
+// Newlines are located with the widest kernel the CPU supports (AVX-512BW,
+// AVX2, SSE2 or NEON, scalar otherwise), picked once at runtime, and lines
+// are handed out in batches of offsets so callers avoid per-line copies.
+class LineScanner {
+public:
+    enum class Isa { Scalar, SSE2, AVX2, AVX512, NEON };
+
+    // stripCarriageReturn: treat "\r\n" as the terminator. Off reproduces
+    // getline exactly (a trailing '\r' stays part of the line).
+    explicit LineScanner(std::string_view buffer, bool stripCarriageReturn = true);
+
+    // Fills up to `capacity` spans with the next lines; returns how many were
+    // written (0 once the buffer is exhausted). A final line without a
+    // terminator is reported like any other.
+    size_t nextBatch(LineSpan* out, size_t capacity);
+
+    bool done() const { return pos_ >= buffer_.size() && !pendingTail_; }
+    std::string_view buffer() const { return buffer_; }
+    std::string_view line(const LineSpan& span) const { return buffer_.substr(span.offset, span.length); }
+
+    // Number of lines getline would produce for this buffer
+    static size_t countLines(std::string_view buffer);
+
+    // Kernel selection (detected once; forceIsa is for benchmarks and fails
+    // if the CPU or build lacks the instruction set)
+    static Isa activeIsa();
+    static bool forceIsa(Isa isa);
+    static bool isaSupported(Isa isa);
+    static const char* isaName(Isa isa);
+
+private:
+    std::string_view buffer_;
+    size_t pos_ = 0;              // Start of the next unscanned line
+    bool stripCR_;
+    bool pendingTail_;
+};
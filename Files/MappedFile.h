@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a regular file (RAII).
+// A file that cannot be mapped (pipe, device, empty, missing) leaves the
+// object invalid; callers should fall back to streaming reads.
+class MappedFile {
+public:
+    // Readahead hint: front-to-back scans vs lookups at scattered offsets
+    enum class Access { Sequential, Random };
+
+    explicit MappedFile(const std::string& filename, Access access = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool valid() const { return data_ != nullptr; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    void unmap();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
@@ -0,0 +1,125 @@
+#include "ParallelFileReader.h"
+#include "FileReader.h"
+#include "StreamDecompressor.h"
+
+#include <atomic>
+#include <cstring>
+
+ParallelFileReader::ParallelFileReader(const std::string& filename)
+    : ParallelFileReader(filename, Options{}) {
+}
+
+ParallelFileReader::ParallelFileReader(const std::string& filename, Options options)
+    : filename_(filename), options_(options), pool_(options.threads) {
+    if (options_.chunkSize == 0) options_.chunkSize = Options{}.chunkSize;
+}
+
+bool ParallelFileReader::prepare(MappedFile& mapped, std::vector<Chunk>& chunks) {
+    if (!mapped.valid()) return false;
+    // Compressed bytes cannot be cut at newlines; FileReader decompresses
+    if (StreamDecompressor::detect(mapped.view()) != Compression::None) return false;
+
+    // Cut at the first newline after each chunkSize step
+    const char* data = mapped.data();
+    const size_t size = mapped.size();
+    size_t begin = 0;
+    while (begin < size) {
+        size_t end = begin + options_.chunkSize;
+        if (end >= size) {
+            end = size;
+        } else {
+            auto* nl = static_cast<const char*>(memchr(data + end, '\n', size - end));
+            end = nl ? static_cast<size_t>(nl - data) + 1 : size;
+        }
+        chunks.push_back(Chunk{begin, end, 0});
+        begin = end;
+    }
+
+    // Every chunk but the last ends in '\n', so per-chunk counts add up
+    std::vector<size_t> counts(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        pool_.submit([&, i] {
+            counts[i] = LineScanner::countLines(mapped.view().substr(chunks[i].begin, chunks[i].end - chunks[i].begin));
+        });
+    }
+    pool_.wait();
+
+    size_t nextLine = 1;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        chunks[i].firstLine = nextLine;
+        nextLine += counts[i];
+    }
+    return true;
+}
+
+void ParallelFileReader::runChunks(size_t count, const std::function<void(size_t)>& work,
+                                   const std::function<void(size_t)>& done, Ordering ordering) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<size_t> completed;   // Chunk indices in completion order
+    std::vector<bool> ready(count, false);
+    bool failed = false;             // A chunk threw; the pool holds the exception
+    std::atomic<bool> cancelled{false};
+
+    for (size_t i = 0; i < count; ++i) {
+        pool_.submit([&, i] {
+            if (cancelled.load(std::memory_order_relaxed)) return;
+            try {
+                work(i);
+            } catch (...) {
+                cancelled.store(true, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+                finished.notify_one();
+                throw;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            completed.push_back(i);
+            ready[i] = true;
+            finished.notify_one();
+        });
+    }
+
+    // Hand finished chunks to `done` on this thread while workers continue
+    size_t delivered = 0, nextOrdered = 0, nextCompleted = 0;
+    try {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (delivered < count) {
+            finished.wait(lock, [&] {
+                return failed || (ordering == Ordering::Ordered ? ready[nextOrdered] : nextCompleted < completed.size());
+            });
+            if (failed) break;
+            size_t index = ordering == Ordering::Ordered ? nextOrdered++ : completed[nextCompleted++];
+            lock.unlock();
+            done(index);
+            ++delivered;
+            lock.lock();
+        }
+    } catch (...) {
+        // The tasks reference this frame: let them drain before unwinding
+        cancelled.store(true, std::memory_order_relaxed);
+        try {
+            pool_.wait();
+        } catch (...) {
+        }
+        throw;
+    }
+    pool_.wait();  // Rethrows the first exception from work
+}
+
+bool ParallelFileReader::forEachLine(const LineTask& onLine) {
+    MappedFile mapped(filename_);
+    std::vector<Chunk> chunks;
+    if (!prepare(mapped, chunks)) {
+        size_t lineNumber = 1;
+        FileReader reader(filename_);
+        return reader.forEachLine([&](std::string_view line) { onLine(lineNumber++, line); });
+    }
+
+    std::string_view text = mapped.view();
+    runChunks(chunks.size(),
+        [&](size_t i) { scanChunk(text, chunks[i], onLine); },
+        [](size_t) {},
+        Ordering::Unordered);
+    return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "LineScanner.h"
+#include "MappedFile.h"
+#include "../Concurrency/WorkStealingPool.h"
+
+// Multi-threaded counterpart of FileReader::forEachLine. A mapped file is
+// cut into chunks that end on newline boundaries; a line-count pass fixes
+// each chunk's first line number, then a work-stealing pool runs the
+// per-line work. Files that cannot be mapped and gzip or zstd files
+// (detected by magic bytes) are processed serially through FileReader.
+class ParallelFileReader {
+public:
+    enum class Ordering { Unordered, Ordered };
+
+    struct Options {
+        size_t threads = 0;                 // 0 = hardware concurrency
+        size_t chunkSize = 4 * 1024 * 1024; // Target bytes per chunk
+    };
+
+    // Line numbers are 1-based, as in secureFileProcessing
+    using LineTask = std::function<void(size_t lineNumber, std::string_view line)>;
+
+    explicit ParallelFileReader(const std::string& filename);
+    ParallelFileReader(const std::string& filename, Options options);
+
+    // Runs onLine concurrently on the workers (it must be thread-safe).
+    // Returns false if the file cannot be opened. If onLine throws, chunks
+    // not yet started are skipped and the first exception is rethrown here
+    // once the workers are idle.
+    bool forEachLine(const LineTask& onLine);
+
+    // Maps every line through fn on the workers and feeds the results to
+    // sink on the calling thread, either in line order or as chunks finish.
+    // fn: R(size_t lineNumber, string_view line); sink: void(size_t lineNumber, R&&)
+    // An exception from fn or sink propagates as for forEachLine; sink
+    // sees no lines after it.
+    template <typename Fn, typename Sink>
+    bool mapLines(Fn&& fn, Sink&& sink, Ordering ordering);
+
+    size_t threadCount() const { return pool_.size(); }
+
+private:
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        size_t firstLine;
+    };
+
+    // Maps the file and computes chunk boundaries and first line numbers
+    bool prepare(MappedFile& mapped, std::vector<Chunk>& chunks);
+
+    // Runs work(chunk) for every chunk on the pool and calls done(chunk) on
+    // the calling thread for each finished chunk in the requested order.
+    // Stops delivering once work or done throws and rethrows that exception.
+    void runChunks(size_t count, const std::function<void(size_t)>& work,
+                   const std::function<void(size_t)>& done, Ordering ordering);
+
+    // Visits the lines of one chunk with their line numbers
+    template <typename Visit>
+    static void scanChunk(std::string_view text, const Chunk& chunk, Visit&& visit);
+
+    std::string filename_;
+    Options options_;
+    WorkStealingPool pool_;
+};
+
+template <typename Visit>
+void ParallelFileReader::scanChunk(std::string_view text, const Chunk& chunk, Visit&& visit) {
+    constexpr size_t batch = 512;
+    LineSpan spans[batch];
+    LineScanner scanner(text.substr(chunk.begin, chunk.end - chunk.begin), false);
+    size_t lineNumber = chunk.firstLine;
+    while (size_t n = scanner.nextBatch(spans, batch)) {
+        for (size_t i = 0; i < n; ++i) visit(lineNumber++, scanner.line(spans[i]));
+    }
+}
+
+template <typename Fn, typename Sink>
+bool ParallelFileReader::mapLines(Fn&& fn, Sink&& sink, Ordering ordering) {
+    using Result = std::decay_t<decltype(fn(size_t{}, std::string_view{}))>;
+
+    MappedFile mapped(filename_);
+    std::vector<Chunk> chunks;
+    if (!prepare(mapped, chunks)) {
+        // Serial fallback: pipes, devices, empty and compressed files
+        return forEachLine([&](size_t lineNumber, std::string_view line) {
+            sink(lineNumber, fn(lineNumber, line));
+        });
+    }
+
+    std::string_view text = mapped.view();
+    std::vector<std::vector<Result>> results(chunks.size());
+    runChunks(chunks.size(),
+        [&](size_t i) {
+            scanChunk(text, chunks[i], [&](size_t lineNumber, std::string_view line) {
+                results[i].push_back(fn(lineNumber, line));
+            });
+        },
+        [&](size_t i) {
+            size_t lineNumber = chunks[i].firstLine;
+            for (auto& result : results[i]) sink(lineNumber++, std::move(result));
+            std::vector<Result>().swap(results[i]);  // Release as we go
+        },
+        ordering);
+    return true;
+}
@@ -0,0 +1,246 @@
+#include "StreamDecompressor.h"
+#include "../Concurrency/SpscQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef FILEREADER_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef FILEREADER_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+constexpr size_t kStreamBlock = 256 * 1024;
+constexpr size_t kMaxSlice = 1u << 30;  // zlib counts input in 32-bit uInt
+
+// One decoder state; decode() is called with whatever input is left
+class Codec {
+public:
+    virtual ~Codec() = default;
+    // Decodes from `in` into out[0, capacity), advancing `in` past what was
+    // consumed; returns the bytes written
+    virtual size_t decode(std::string_view& in, char* out, size_t capacity) = 0;
+    // True when the input so far ends exactly at the end of a stream/frame
+    virtual bool complete() const = 0;
+};
+
+#ifdef FILEREADER_WITH_ZLIB
+class GzipCodec : public Codec {
+public:
+    GzipCodec() {
+        // 15 + 32: maximum window, gzip or zlib header detected automatically
+        if (inflateInit2(&stream_, 15 + 32) != Z_OK) throw DecompressError("gzip: inflateInit2 failed");
+    }
+    ~GzipCodec() override { inflateEnd(&stream_); }
+
+    size_t decode(std::string_view& in, char* out, size_t capacity) override {
+        if (ended_) {
+            if (in.empty()) return 0;
+            inflateReset(&stream_);  // Next member of a concatenated file
+            ended_ = false;
+        }
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+        stream_.avail_in = static_cast<uInt>(in.size());
+        stream_.next_out = reinterpret_cast<Bytef*>(out);
+        stream_.avail_out = static_cast<uInt>(capacity);
+        int rc = inflate(&stream_, Z_NO_FLUSH);
+        if (rc == Z_STREAM_END) {
+            ended_ = true;
+        } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            throw DecompressError(std::string("gzip: ") + (stream_.msg ? stream_.msg : "corrupt data"));
+        }
+        in.remove_prefix(in.size() - stream_.avail_in);
+        return capacity - stream_.avail_out;
+    }
+
+    bool complete() const override { return ended_; }
+
+private:
+    z_stream stream_{};
+    bool ended_ = false;
+};
+#endif
+
+#ifdef FILEREADER_WITH_ZSTD
+class ZstdCodec : public Codec {
+public:
+    ZstdCodec() : context_(ZSTD_createDCtx()) {
+        if (!context_) throw DecompressError("zstd: ZSTD_createDCtx failed");
+    }
+    ~ZstdCodec() override { ZSTD_freeDCtx(context_); }
+
+    size_t decode(std::string_view& in, char* out, size_t capacity) override {
+        ZSTD_inBuffer input{in.data(), in.size(), 0};
+        ZSTD_outBuffer output{out, capacity, 0};
+        size_t rc = ZSTD_decompressStream(context_, &output, &input);
+        if (ZSTD_isError(rc)) throw DecompressError(std::string("zstd: ") + ZSTD_getErrorName(rc));
+        // 0: a frame ended and everything is flushed. A call that moved
+        // nothing (no input left) only reports the next header's size.
+        if (input.pos > 0 || output.pos > 0) frameDone_ = rc == 0;
+        in.remove_prefix(input.pos);
+        return output.pos;
+    }
+
+    bool complete() const override { return frameDone_; }
+
+private:
+    ZSTD_DCtx* context_;
+    bool frameDone_ = false;
+};
+#endif
+
+std::unique_ptr<Codec> makeCodec(Compression format) {
+    switch (format) {
+#ifdef FILEREADER_WITH_ZLIB
+        case Compression::Gzip: return std::make_unique<GzipCodec>();
+#endif
+#ifdef FILEREADER_WITH_ZSTD
+        case Compression::Zstd: return std::make_unique<ZstdCodec>();
+#endif
+        default: break;
+    }
+    throw DecompressError(std::string(StreamDecompressor::name(format)) + ": not supported by this build");
+}
+
+struct Chunk {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+};
+
+} // namespace
+
+StreamDecompressor::StreamDecompressor() : StreamDecompressor(Options{}) {}
+
+StreamDecompressor::StreamDecompressor(Options options) : options_(options) {
+    options_.chunkBytes = std::max<size_t>(options_.chunkBytes, 4096);
+    options_.queueDepth = std::max<size_t>(options_.queueDepth, 1);
+}
+
+Compression StreamDecompressor::detect(std::string_view head) {
+    auto starts = [&](std::string_view magic) { return head.substr(0, magic.size()) == magic; };
+    if (starts("\x1f\x8b")) return Compression::Gzip;
+    if (starts("\x28\xb5\x2f\xfd")) return Compression::Zstd;
+    return Compression::None;
+}
+
+bool StreamDecompressor::supported(Compression format) {
+    switch (format) {
+        case Compression::None: return true;
+#ifdef FILEREADER_WITH_ZLIB
+        case Compression::Gzip: return true;
+#endif
+#ifdef FILEREADER_WITH_ZSTD
+        case Compression::Zstd: return true;
+#endif
+        default: return false;
+    }
+}
+
+const char* StreamDecompressor::name(Compression format) {
+    switch (format) {
+        case Compression::None: return "none";
+        case Compression::Gzip: return "gzip";
+        case Compression::Zstd: return "zstd";
+    }
+    return "?";
+}
+
+uint64_t StreamDecompressor::decompress(std::string_view input, Compression format, const ChunkCallback& onChunk) {
+    return run([input]() mutable {
+        std::string_view slice = input.substr(0, kMaxSlice);
+        input.remove_prefix(slice.size());
+        return slice;
+    }, format, onChunk);
+}
+
+uint64_t StreamDecompressor::decompress(std::istream& input, std::string_view prefix, Compression format,
+                                        const ChunkCallback& onChunk) {
+    std::unique_ptr<char[]> block;
+    return run([&, prefix]() mutable -> std::string_view {
+        if (!prefix.empty()) return std::exchange(prefix, {});
+        if (!block) block = std::make_unique_for_overwrite<char[]>(kStreamBlock);
+        input.read(block.get(), static_cast<std::streamsize>(kStreamBlock));
+        return {block.get(), static_cast<size_t>(input.gcount())};
+    }, format, onChunk);
+}
+
+uint64_t StreamDecompressor::run(const InputSource& next, Compression format, const ChunkCallback& onChunk) {
+    std::unique_ptr<Codec> codec = makeCodec(format);
+
+    // Chunks circulate worker -> filled -> caller -> free -> worker; a
+    // nullptr in `filled` ends the stream. The free list is the back-pressure.
+    const size_t chunkCount = options_.queueDepth + 1;
+    std::vector<Chunk> chunks(chunkCount);
+    SpscQueue<Chunk*> filled(chunkCount + 1), free(chunkCount);
+    for (Chunk& chunk : chunks) {
+        chunk.data = std::make_unique_for_overwrite<char[]>(options_.chunkBytes);
+        free.push(&chunk);
+    }
+
+    std::atomic<bool> stop{false};
+    std::exception_ptr workerError;
+    std::thread worker([&] {
+        try {
+            std::string_view in;
+            bool endOfInput = false;
+            bool finished = false;
+            while (!finished && !stop.load(std::memory_order_relaxed)) {
+                Chunk* chunk = free.pop();
+                chunk->size = 0;
+                while (chunk->size < options_.chunkBytes) {
+                    if (in.empty() && !endOfInput) {
+                        in = next();
+                        endOfInput = in.empty();
+                    }
+                    size_t before = in.size();
+                    size_t n = codec->decode(in, chunk->data.get() + chunk->size, options_.chunkBytes - chunk->size);
+                    chunk->size += n;
+                    if (n == 0 && in.size() == before) {
+                        // No progress: only legitimate once the input is used up
+                        if (!endOfInput) throw DecompressError(std::string(name(format)) + ": decoder stalled");
+                        if (!codec->complete()) throw DecompressError(std::string(name(format)) + ": truncated input");
+                        finished = true;
+                        break;
+                    }
+                }
+                // An empty chunk only happens at the end, and the worker
+                // stops right after; pushing it back onto `free` would make
+                // this thread a second producer of that SPSC queue
+                if (chunk->size > 0) filled.push(chunk);
+            }
+        } catch (...) {
+            workerError = std::current_exception();
+        }
+        filled.push(nullptr);
+    });
+
+    // The caller's side: hand chunks to the callback; after a callback
+    // throws, keep recycling so the worker can reach its end marker
+    uint64_t total = 0;
+    std::exception_ptr callbackError;
+    while (Chunk* chunk = filled.pop()) {
+        if (!callbackError) {
+            try {
+                onChunk(std::string_view(chunk->data.get(), chunk->size));
+                total += chunk->size;
+            } catch (...) {
+                callbackError = std::current_exception();
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+        free.push(chunk);
+    }
+    worker.join();
+
+    if (callbackError) std::rethrow_exception(callbackError);
+    if (workerError) std::rethrow_exception(workerError);
+    return total;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <stdexcept>
+#include <string_view>
+
+// Compression formats recognized by their magic bytes
+enum class Compression { None, Gzip, Zstd };
+
+// Corrupt or truncated input, or a format this build has no codec for
+class DecompressError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Streams the decompressed bytes of gzip (including concatenated members)
+// or zstd input to a callback, chunkBytes at a time. Decompression runs on
+// its own thread up to queueDepth chunks ahead of the callback, so
+// inflating the next chunk overlaps with processing the current one.
+class StreamDecompressor {
+public:
+    struct Options {
+        size_t chunkBytes = 256 * 1024;
+        size_t queueDepth = 4;
+    };
+
+    // A chunk of decompressed bytes (lines may span chunks); the view is
+    // only valid during the call
+    using ChunkCallback = std::function<void(std::string_view)>;
+
+    StreamDecompressor();
+    explicit StreamDecompressor(Options options);
+
+    // Format of data starting with `head` (4 bytes are enough)
+    static Compression detect(std::string_view head);
+    // Whether this build has the codec (zlib / libzstd are optional)
+    static bool supported(Compression format);
+    static const char* name(Compression format);
+
+    // Input already in memory, e.g. a MappedFile. Returns the decompressed
+    // size. Throws DecompressError for bad input; callback exceptions are
+    // rethrown after the worker has stopped.
+    uint64_t decompress(std::string_view input, Compression format, const ChunkCallback& onChunk);
+
+    // Input read from a stream by the worker; `prefix` holds bytes the
+    // caller already took from it (e.g. to sniff the magic)
+    uint64_t decompress(std::istream& input, std::string_view prefix, Compression format,
+                        const ChunkCallback& onChunk);
+
+private:
+    using InputSource = std::function<std::string_view()>;  // Empty view at end of input
+    uint64_t run(const InputSource& next, Compression format, const ChunkCallback& onChunk);
+
+    Options options_;
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace format_security {
+
+// Per-byte rules compiled into 256-entry tables at compile time. A policy
+// is a list of rules applied in order, later rules overriding earlier
+// ones for the bytes they touch:
+//
+//   using Policy = CharPolicy<charpolicy::Mark<kControlClass, 0x00, 0x1f>,
+//                             charpolicy::Unmark<kControlClass, '\t'>,
+//                             charpolicy::Replace<'_', '%'>>;
+//
+// Policy::table is a constant; checking or rewriting a string is one
+// lookup per byte with no branches and no runtime setup, and every policy
+// gets its own instantiation of the loops below.
+
+// Byte classes the policies in this module assign; a byte may carry several
+enum : uint8_t {
+    kControlClass = 1 << 0,  // Control characters the policy rejects
+    kFormatClass = 1 << 1,   // printf conversion introducer '%'
+};
+
+struct CharTable {
+    std::array<uint8_t, 256> classes{};
+    std::array<char, 256> replacement{};  // Identity unless a rule replaces the byte
+};
+
+namespace charpolicy {
+
+template <uint8_t Class, unsigned char First, unsigned char Last = First>
+struct Mark {
+    static_assert(First <= Last);
+    static constexpr void apply(CharTable& table) {
+        for (unsigned b = First; b <= Last; ++b) table.classes[b] |= Class;
+    }
+};
+
+template <uint8_t Class, unsigned char First, unsigned char Last = First>
+struct Unmark {
+    static_assert(First <= Last);
+    static constexpr void apply(CharTable& table) {
+        for (unsigned b = First; b <= Last; ++b) table.classes[b] &= static_cast<uint8_t>(~Class);
+    }
+};
+
+template <char With, unsigned char First, unsigned char Last = First>
+struct Replace {
+    static_assert(First <= Last);
+    static constexpr void apply(CharTable& table) {
+        for (unsigned b = First; b <= Last; ++b) table.replacement[b] = With;
+    }
+};
+
+// Rule that only applies when Enabled (e.g. depends on char signedness)
+template <bool Enabled, typename Rule>
+struct When {
+    static constexpr void apply(CharTable& table) {
+        if constexpr (Enabled) Rule::apply(table);
+    }
+};
+
+} // namespace charpolicy
+
+template <typename... Rules>
+class CharPolicy {
+public:
+    static constexpr CharTable table = [] {
+        CharTable built{};
+        for (size_t b = 0; b < built.replacement.size(); ++b) built.replacement[b] = static_cast<char>(b);
+        (Rules::apply(built), ...);
+        return built;
+    }();
+
+    static constexpr uint8_t classify(char c) { return table.classes[static_cast<unsigned char>(c)]; }
+    static constexpr char map(char c) { return table.replacement[static_cast<unsigned char>(c)]; }
+
+    // Union of the classes of every byte in text
+    static constexpr uint8_t classesIn(std::string_view text) {
+        uint8_t seen = 0;
+        for (char c : text) seen |= classify(c);
+        return seen;
+    }
+
+    // out[i] = map(in[i]); out must hold in.size() bytes and may equal in
+    static constexpr void transform(std::string_view in, char* out) {
+        for (size_t i = 0; i < in.size(); ++i) out[i] = map(in[i]);
+    }
+};
+
+// isValidFilename's byte rules: control characters other than tab, and
+// '%'. Its original test compared plain `char` against 32, so where char
+// is signed bytes >= 0x80 are control characters too.
+using FilenamePolicy = CharPolicy<charpolicy::Mark<kControlClass, 0x00, 0x1f>,
+                                  charpolicy::Unmark<kControlClass, '\t'>,
+                                  charpolicy::When<std::is_signed_v<char>, charpolicy::Mark<kControlClass, 0x80, 0xff>>,
+                                  charpolicy::Mark<kFormatClass, '%'>>;
+
+// sanitizeInput's rewrite: '%', '\n' and '\r' become '_'
+using SanitizePolicy = CharPolicy<charpolicy::Replace<'_', '%'>,
+                                  charpolicy::Replace<'_', '\n'>,
+                                  charpolicy::Replace<'_', '\r'>>;
+
+// Control bytes PatternScanner flags in file content: below 0x20 except
+// tab, LF and CR, plus DEL
+using ContentControlPolicy = CharPolicy<charpolicy::Mark<kControlClass, 0x00, 0x1f>,
+                                        charpolicy::Unmark<kControlClass, '\t'>,
+                                        charpolicy::Unmark<kControlClass, '\n'>,
+                                        charpolicy::Unmark<kControlClass, '\r'>,
+                                        charpolicy::Mark<kControlClass, 0x7f>>;
+
+} // namespace format_security
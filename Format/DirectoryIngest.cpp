@@ -0,0 +1,72 @@
+#include "DirectoryIngest.h"
+#include "FilenameValidator.h"
+
+#include <filesystem>
+#include <system_error>
+
+namespace format_security {
+
+namespace fs = std::filesystem;
+
+DirectoryIngest::DirectoryIngest() : DirectoryIngest(Options{}) {}
+
+DirectoryIngest::DirectoryIngest(Options options) : options_(options), reader_(options.read) {}
+
+std::vector<std::string> DirectoryIngest::collect(const std::string& directory, std::vector<std::string>* relative,
+                                                  Stats& stats) const {
+    std::vector<std::string> full;
+    FilenameBatch names;
+    std::error_code ec;
+    const std::string root = fs::path(directory).string();
+    const size_t prefix = root.size() + (root.empty() || root.back() == '/' ? 0 : 1);
+
+    auto visit = [&](const fs::directory_entry& entry) {
+        // is_regular_file on an entry uses the type readdir reported: no stat
+        std::error_code typeError;
+        if (!entry.is_regular_file(typeError)) return;
+        std::string path = entry.path().string();
+        names.add(path.substr(std::min(prefix, path.size())));
+        full.push_back(std::move(path));
+    };
+    if (options_.recursive) {
+        fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec), end;
+        for (; !ec && it != end; it.increment(ec)) visit(*it);
+    } else {
+        fs::directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec), end;
+        for (; !ec && it != end; it.increment(ec)) visit(*it);
+    }
+    stats.scanned = full.size();
+
+    // One vectorized pass over every name instead of a call per file
+    std::vector<FilenameVerdict> verdicts = FilenameValidator::validate(names);
+    size_t kept = 0;
+    if (relative) relative->clear();
+    for (size_t i = 0; i < full.size(); ++i) {
+        if (verdicts[i] != FilenameVerdict::Valid) continue;
+        if (relative) {
+            relative->emplace_back(names.data, names.offsets[i], names.offsets[i + 1] - names.offsets[i]);
+        }
+        if (kept != i) full[kept] = std::move(full[i]);
+        ++kept;
+    }
+    full.resize(kept);
+    stats.rejected = stats.scanned - kept;
+    return full;
+}
+
+DirectoryIngest::Stats DirectoryIngest::run(const std::string& directory, const FileCallback& onFile) {
+    Stats stats;
+    std::vector<std::string> relative;
+    std::vector<std::string> paths = collect(directory, &relative, stats);
+
+    auto result = reader_.readAll(paths, [&](size_t index, std::string_view contents) {
+        if (onFile) onFile(relative[index], contents);
+    });
+    stats.read = result.files;
+    stats.failed = result.failed;
+    stats.bytes = result.bytes;
+    stats.backend = result.backend;
+    return stats;
+}
+
+} // namespace format_security
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Files/BatchFileReader.h"
+
+namespace format_security {
+
+// Batch mode of secureFileProcessing: walks a directory, keeps the regular
+// files whose paths (relative to the directory) pass the same checks as
+// FormatDemo::isValidFilename, and reads them with a BatchFileReader.
+class DirectoryIngest {
+public:
+    struct Options {
+        bool recursive = true;
+        BatchFileReader::Options read;
+    };
+
+    struct Stats {
+        size_t scanned = 0;   // Regular files found
+        size_t rejected = 0;  // Failed filename validation
+        size_t read = 0;
+        size_t failed = 0;    // Open/read errors
+        uint64_t bytes = 0;
+        BatchFileReader::Backend backend = BatchFileReader::Backend::ThreadPool;
+    };
+
+    // relativePath uses '/' separators; contents is valid during the call only
+    using FileCallback = std::function<void(const std::string& relativePath, std::string_view contents)>;
+
+    DirectoryIngest();
+    explicit DirectoryIngest(Options options);
+
+    // Valid files under directory as full paths (plus their relative forms)
+    std::vector<std::string> collect(const std::string& directory, std::vector<std::string>* relative,
+                                     Stats& stats) const;
+
+    // Same threading as BatchFileReader::readAll: onFile may run
+    // concurrently on pool threads when io_uring is unavailable
+    Stats run(const std::string& directory, const FileCallback& onFile);
+
+private:
+    Options options_;
+    BatchFileReader reader_;
+};
+
+} // namespace format_security
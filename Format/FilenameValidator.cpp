@@ -0,0 +1,322 @@
+#include "FilenameValidator.h"
+#include "CharPolicy.h"
+#include "../Logging/Trace.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FILENAMEVALIDATOR_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FILENAMEVALIDATOR_NEON 1
+#endif
+
+namespace format_security {
+
+namespace {
+
+constexpr size_t kBlock = 64;
+
+// One bit per byte of a 64-byte block
+struct BlockMasks {
+    uint64_t control;
+    uint64_t percent;
+    uint64_t dot;
+};
+
+// The SIMD kernels cannot look bytes up in FilenamePolicy's table, so
+// they test its control class as "below kControlLimit, except
+// kControlExempt" (a signed compare when bytes >= 0x80 are control, which
+// is isValidFilename's plain-char test where char is signed) and its
+// format class as equality with kFormatByte. All four are read off the
+// table, and the static_assert below checks that this model reproduces
+// the table for every byte, so a policy the kernels cannot express fails
+// to compile instead of diverging from masksScalar.
+constexpr const CharTable& kPolicy = FilenamePolicy::table;
+
+constexpr bool isControl(unsigned b) { return (kPolicy.classes[b] & kControlClass) != 0; }
+
+constexpr bool kSignedCompare = isControl(0x80);
+
+constexpr unsigned kControlLimit = [] {
+    unsigned limit = 0;
+    for (unsigned b = 0; b < 0x80; ++b) {
+        if (isControl(b)) limit = b + 1;
+    }
+    return limit;
+}();
+
+// The one byte below kControlLimit the policy lets through (256: none)
+constexpr unsigned kControlExempt = [] {
+    unsigned exempt = 256;
+    for (unsigned b = 0; b < kControlLimit; ++b) {
+        if (!isControl(b)) exempt = exempt == 256 ? b : 257;
+    }
+    return exempt;
+}();
+
+// The one byte in the format class (256: none, 257: several)
+constexpr unsigned kFormatByte = [] {
+    unsigned found = 256;
+    for (unsigned b = 0; b < 256; ++b) {
+        if (kPolicy.classes[b] & kFormatClass) found = found == 256 ? b : 257;
+    }
+    return found;
+}();
+
+// ".." is a two-byte pattern rather than a byte class, so it is not part
+// of the policy
+constexpr char kDot = '.';
+
+constexpr bool kernelsMatchPolicy() {
+    if (kControlLimit == 0 || kControlLimit >= 0x80 || kControlExempt > 255 || kFormatByte > 255) return false;
+    for (unsigned b = 0; b < 256; ++b) {
+        bool below = kSignedCompare ? static_cast<int8_t>(b) < static_cast<int>(kControlLimit) : b < kControlLimit;
+        if ((below && b != kControlExempt) != isControl(b)) return false;
+        if ((b == kFormatByte) != ((kPolicy.classes[b] & kFormatClass) != 0)) return false;
+    }
+    return true;
+}
+static_assert(kernelsMatchPolicy(), "FilenamePolicy no longer fits the SIMD kernels' compare model");
+
+BlockMasks masksScalar(const char* p) {
+    BlockMasks m{0, 0, 0};
+    for (size_t i = 0; i < kBlock; ++i) {
+        uint8_t classes = FilenamePolicy::classify(p[i]);
+        m.control |= uint64_t{(classes & kControlClass) != 0} << i;
+        m.percent |= uint64_t{(classes & kFormatClass) != 0} << i;
+        m.dot |= uint64_t{p[i] == kDot} << i;
+    }
+    return m;
+}
+
+#ifdef FILENAMEVALIDATOR_X86
+
+__attribute__((target("sse2")))
+BlockMasks masksSSE2(const char* p) {
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(kControlLimit));
+    const __m128i exempt = _mm_set1_epi8(static_cast<char>(kControlExempt));
+    const __m128i percent = _mm_set1_epi8(static_cast<char>(kFormatByte)), dot = _mm_set1_epi8(kDot);
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+    BlockMasks m{0, 0, 0};
+    for (size_t k = 0; k < kBlock; k += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+        // Unsigned compare: flip the sign bits so the signed compare orders bytes unsigned
+        __m128i cmp = kSignedCompare ? v : _mm_xor_si128(v, bias);
+        __m128i bound = kSignedCompare ? limit : _mm_xor_si128(limit, bias);
+        __m128i control = _mm_andnot_si128(_mm_cmpeq_epi8(v, exempt), _mm_cmplt_epi8(cmp, bound));
+        m.control |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(control))) << k;
+        m.percent |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, percent)))) << k;
+        m.dot |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, dot)))) << k;
+    }
+    return m;
+}
+
+__attribute__((target("avx2")))
+BlockMasks masksAVX2(const char* p) {
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(kControlLimit));
+    const __m256i exempt = _mm256_set1_epi8(static_cast<char>(kControlExempt));
+    const __m256i percent = _mm256_set1_epi8(static_cast<char>(kFormatByte)), dot = _mm256_set1_epi8(kDot);
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(0x80));
+    BlockMasks m{0, 0, 0};
+    for (size_t k = 0; k < kBlock; k += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k));
+        __m256i cmp = kSignedCompare ? v : _mm256_xor_si256(v, bias);
+        __m256i bound = kSignedCompare ? limit : _mm256_xor_si256(limit, bias);
+        __m256i control = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, exempt), _mm256_cmpgt_epi8(bound, cmp));
+        m.control |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(control))) << k;
+        m.percent |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, percent)))) << k;
+        m.dot |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, dot)))) << k;
+    }
+    return m;
+}
+
+#endif // FILENAMEVALIDATOR_X86
+
+#ifdef FILENAMEVALIDATOR_NEON
+
+// 16 compare lanes -> 16-bit movemask
+inline uint64_t neonMovemask(uint8x16_t cmp) {
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(cmp, vld1q_u8(weights));
+    return vaddv_u8(vget_low_u8(bits)) | (static_cast<uint64_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+}
+
+BlockMasks masksNEON(const char* p) {
+    BlockMasks m{0, 0, 0};
+    for (size_t k = 0; k < kBlock; k += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p + k));
+        uint8x16_t below = kSignedCompare
+            ? vcltq_s8(vreinterpretq_s8_u8(v), vdupq_n_s8(static_cast<int8_t>(kControlLimit)))
+            : vcltq_u8(v, vdupq_n_u8(kControlLimit));
+        uint8x16_t control = vbicq_u8(below, vceqq_u8(v, vdupq_n_u8(kControlExempt)));
+        m.control |= neonMovemask(control) << k;
+        m.percent |= neonMovemask(vceqq_u8(v, vdupq_n_u8(kFormatByte))) << k;
+        m.dot |= neonMovemask(vceqq_u8(v, vdupq_n_u8(kDot))) << k;
+    }
+    return m;
+}
+
+#endif // FILENAMEVALIDATOR_NEON
+
+struct Kernel {
+    FilenameValidator::Isa isa;
+    BlockMasks (*masks)(const char*);
+};
+
+const Kernel kScalar{FilenameValidator::Isa::Scalar, masksScalar};
+#ifdef FILENAMEVALIDATOR_X86
+const Kernel kSSE2{FilenameValidator::Isa::SSE2, masksSSE2};
+const Kernel kAVX2{FilenameValidator::Isa::AVX2, masksAVX2};
+#endif
+#ifdef FILENAMEVALIDATOR_NEON
+const Kernel kNEON{FilenameValidator::Isa::NEON, masksNEON};
+#endif
+
+const Kernel* kernelFor(FilenameValidator::Isa isa) {
+    switch (isa) {
+        case FilenameValidator::Isa::Scalar: return &kScalar;
+#ifdef FILENAMEVALIDATOR_X86
+        case FilenameValidator::Isa::SSE2: return &kSSE2;
+        case FilenameValidator::Isa::AVX2: return __builtin_cpu_supports("avx2") ? &kAVX2 : nullptr;
+#endif
+#ifdef FILENAMEVALIDATOR_NEON
+        case FilenameValidator::Isa::NEON: return &kNEON;
+#endif
+        default: return nullptr;
+    }
+}
+
+const Kernel* detectKernel() {
+    for (auto isa : {FilenameValidator::Isa::AVX2, FilenameValidator::Isa::SSE2, FilenameValidator::Isa::NEON}) {
+        if (const Kernel* k = kernelFor(isa)) return k;
+    }
+    return &kScalar;
+}
+
+std::atomic<const Kernel*>& activeKernel() {
+    static std::atomic<const Kernel*> active{detectKernel()};
+    return active;
+}
+
+// Per-name findings gathered during the scan
+enum : uint8_t { kHasTraversal = 1, kHasControl = 2, kHasPercent = 4 };
+
+} // namespace
+
+size_t FilenameValidator::validate(const char* data, const uint32_t* offsets, size_t count,
+                                   FilenameVerdict* verdicts) {
+    const auto blockMasks = activeKernel().load(std::memory_order_relaxed)->masks;
+
+    // Findings are staged in the verdict array itself, then finalized
+    auto* flags = reinterpret_cast<uint8_t*>(verdicts);
+    std::memset(flags, 0, count);
+
+    const size_t begin = offsets[0];
+    const size_t end = offsets[count];
+    size_t entry = 0;         // Name containing the current flagged byte
+    uint64_t prevDot = 0;     // Whether the byte before this block was '.'
+    char tail[kBlock];
+
+    for (size_t pos = begin; pos < end; pos += kBlock) {
+        size_t len = end - pos < kBlock ? end - pos : kBlock;
+        const char* block = data + pos;
+        if (len < kBlock) {
+            // Pad the tail with a byte no check flags, then mask it away
+            std::memset(tail, 'a', kBlock);
+            std::memcpy(tail, block, len);
+            block = tail;
+        }
+        BlockMasks m = blockMasks(block);
+
+        // ".." ends at every dot whose predecessor is a dot
+        uint64_t pairEnd = m.dot & ((m.dot << 1) | prevDot);
+        prevDot = m.dot >> 63;
+
+        uint64_t flagged = m.control | m.percent | pairEnd;
+        while (flagged) {
+            size_t bit = static_cast<size_t>(__builtin_ctzll(flagged));
+            uint64_t one = uint64_t{1} << bit;
+            flagged &= flagged - 1;
+            size_t at = pos + bit;
+            while (offsets[entry + 1] <= at) ++entry;
+
+            if (m.control & one) flags[entry] |= kHasControl;
+            if (m.percent & one) flags[entry] |= kHasPercent;
+            // A dot pair straddling two names is not a traversal
+            if ((pairEnd & one) && at > offsets[entry]) flags[entry] |= kHasTraversal;
+        }
+    }
+
+    size_t valid = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = offsets[i + 1] - offsets[i];
+        uint8_t f = flags[i];
+        FilenameVerdict v = length == 0 ? FilenameVerdict::Empty
+                          : (f & kHasTraversal) ? FilenameVerdict::PathTraversal
+                          : (f & kHasControl) ? FilenameVerdict::ControlCharacter
+                          : length > maxLength ? FilenameVerdict::TooLong
+                          : (f & kHasPercent) ? FilenameVerdict::FormatSpecifier
+                          : FilenameVerdict::Valid;
+        verdicts[i] = v;
+        valid += (v == FilenameVerdict::Valid);
+    }
+    TRACE_COUNT(RejectedFilenames, count - valid);
+    return valid;
+}
+
+std::vector<FilenameVerdict> FilenameValidator::validate(const FilenameBatch& batch) {
+    std::vector<FilenameVerdict> verdicts(batch.size());
+    validate(batch.data.data(), batch.offsets.data(), batch.size(), verdicts.data());
+    return verdicts;
+}
+
+std::vector<uint64_t> FilenameValidator::validMask(const FilenameBatch& batch) {
+    std::vector<FilenameVerdict> verdicts = validate(batch);
+    std::vector<uint64_t> mask((verdicts.size() + 63) / 64, 0);
+    for (size_t i = 0; i < verdicts.size(); ++i) {
+        if (verdicts[i] == FilenameVerdict::Valid) mask[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    return mask;
+}
+
+const char* FilenameValidator::describe(FilenameVerdict verdict) {
+    switch (verdict) {
+        case FilenameVerdict::Valid: return "valid";
+        case FilenameVerdict::Empty: return "empty";
+        case FilenameVerdict::PathTraversal: return "path traversal";
+        case FilenameVerdict::ControlCharacter: return "control character";
+        case FilenameVerdict::TooLong: return "too long";
+        case FilenameVerdict::FormatSpecifier: return "format specifier";
+    }
+    return "unknown";
+}
+
+FilenameValidator::Isa FilenameValidator::activeIsa() {
+    return activeKernel().load(std::memory_order_relaxed)->isa;
+}
+
+bool FilenameValidator::forceIsa(Isa isa) {
+    const Kernel* kernel = kernelFor(isa);
+    if (!kernel) return false;
+    activeKernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+bool FilenameValidator::isaSupported(Isa isa) {
+    return kernelFor(isa) != nullptr;
+}
+
+const char* FilenameValidator::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE2: return "sse2";
+        case Isa::AVX2: return "avx2";
+        case Isa::NEON: return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace format_security
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace format_security {
+
+// Why a filename was rejected; checks are reported in the same priority
+// order FormatDemo::isValidFilename applies them
+enum class FilenameVerdict : uint8_t {
+    Valid,
+    Empty,
+    PathTraversal,     // Contains ".."
+    ControlCharacter,  // Byte < 32 other than tab
+    TooLong,           // More than 255 bytes
+    FormatSpecifier,   // Contains '%'
+};
+
+// Many filenames packed back to back: name i is
+// data[offsets[i], offsets[i + 1]), so offsets has count + 1 entries.
+struct FilenameBatch {
+    std::string data;
+    std::vector<uint32_t> offsets{0};
+
+    void add(const std::string& name) {
+        data += name;
+        offsets.push_back(static_cast<uint32_t>(data.size()));
+    }
+    size_t size() const { return offsets.size() - 1; }
+};
+
+// Batch counterpart of FormatDemo::isValidFilename. The whole packed buffer
+// is scanned once, 64 bytes at a time, building masks for control bytes,
+// '%' and ".." together (AVX2, SSE2 or NEON; scalar otherwise). Only the
+// rare flagged bytes are mapped back to their filename.
+class FilenameValidator {
+public:
+    enum class Isa { Scalar, SSE2, AVX2, NEON };
+
+    static constexpr size_t maxLength = 255;
+
+    // Writes one verdict per filename; returns the number of valid names
+    static size_t validate(const char* data, const uint32_t* offsets, size_t count,
+                           FilenameVerdict* verdicts);
+    static std::vector<FilenameVerdict> validate(const FilenameBatch& batch);
+
+    // Bit i of word i / 64 is set when filename i is valid
+    static std::vector<uint64_t> validMask(const FilenameBatch& batch);
+
+    static const char* describe(FilenameVerdict verdict);
+
+    // Kernel selection (detected once; forceIsa is for tests and benchmarks
+    // and fails if the CPU or build lacks the instruction set)
+    static Isa activeIsa();
+    static bool forceIsa(Isa isa);
+    static bool isaSupported(Isa isa);
+    static const char* isaName(Isa isa);
+};
+
+} // namespace format_security
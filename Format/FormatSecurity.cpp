@@ -1,12 +1,52 @@
 #include "FormatSecurity.h"
+#include "CharPolicy.h"
+#include "DirectoryIngest.h"
+#include "FilenameValidator.h"
+#include "PatternScanner.h"
+#include "SafeFormat.h"
+#include "SecurePipeline.h"
+#include "../Files/LineScanner.h"
+#include "../Logging/Trace.h"
 #include <fstream>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <version>
+#ifdef __cpp_lib_format
+#include <format>
+#endif
 
 using namespace std;
 
 namespace format_security {
 
+namespace {
+
+static_assert(SanitizePolicy::map('%') == '_' && SanitizePolicy::map('\r') == '_' && SanitizePolicy::map('a') == 'a');
+static_assert(FilenamePolicy::classify('\t') == 0 && FilenamePolicy::classify('\x1f') == kControlClass);
+
+// The checks behind isValidFilename. Length comes before the byte checks so
+// control characters and '%' share one table pass; the result is a plain
+// bool, so the order only matters to FilenameValidator's verdicts.
+bool filenameAcceptable(const string& filename) {
+    // Check for empty
+    if (filename.empty()) return false;
+    
+    // Check for path traversal
+    if (filename.find("..") != string::npos) return false;
+    
+    // Check length
+    if (filename.length() > 255) return false;
+    
+    // Control characters (except tab) and format specifiers, one table pass
+    return FilenamePolicy::classesIn(filename) == 0;
+}
+
+} // namespace
+
 void FormatDemo::demonstrateFormatVulnerabilities() {
+    TRACE_SCOPE("FormatDemo::demonstrateFormatVulnerabilities");
     cout << "\n=== FORMAT SECURITY VULNERABILITIES ===\n";
     
     string userInput = "test%x%x%x%x%n";  // Simulated malicious input
@@ -26,6 +66,7 @@ void FormatDemo::demonstrateFormatVulnerabilities() {
 }
 
 void FormatDemo::demonstrateSecureFormatting() {
+    TRACE_SCOPE("FormatDemo::demonstrateSecureFormatting");
     cout << "\n=== SECURE FORMATTING SOLUTIONS ===\n";
     
     string userInput = "user%x%x%data";
@@ -63,15 +104,22 @@ void FormatDemo::demonstrateSecureFormatting() {
     
     // 5. Modern C++20 format (if available)
     cout << "\n5. C++20 std::format (type-safe):\n";
-    #if __cplusplus >= 202002L
+    #ifdef __cpp_lib_format
     string formatted = std::format("   Modern: {} has {} lines", filename, lineCount);
     cout << formatted << '\n';
     #else
-    cout << "   (std::format requires C++20)\n";
+    cout << "   (std::format requires C++20 library support)\n";
     #endif
+    
+    // 6. Compile-time checked format into a stack buffer
+    cout << "\n6. formatFixed (checked at compile time, no allocation):\n";
+    auto checked = formatFixed<128>("   Checked: {} has {} lines, {:.1f} KB", filename, lineCount, fileSize);
+    cout << checked.view() << '\n';
+    cout << "   formatFixed(userInput) would not compile - format must be a literal\n";
 }
 
 void FormatDemo::demonstrateBufferIssues() {
+    TRACE_SCOPE("FormatDemo::demonstrateBufferIssues");
     cout << "\n=== BUFFER OVERFLOW PREVENTION ===\n";
     
     string longFilename = "very_long_filename_that_could_overflow_buffer.txt";
@@ -97,6 +145,7 @@ void FormatDemo::demonstrateBufferIssues() {
 }
 
 void FormatDemo::demonstrateInputValidation() {
+    TRACE_SCOPE("FormatDemo::demonstrateInputValidation");
     cout << "\n=== INPUT VALIDATION ===\n";
     
     vector<string> testInputs = {
@@ -120,9 +169,19 @@ void FormatDemo::demonstrateInputValidation() {
             cout << "❌ Invalid/Rejected\n";
         }
     }
+
+    // Same inputs validated in one pass with reject reasons
+    cout << "\nBatch validation:\n";
+    FilenameBatch batch;
+    for (const auto& input : testInputs) batch.add(input);
+    auto verdicts = FilenameValidator::validate(batch);
+    for (size_t i = 0; i < verdicts.size(); ++i) {
+        cout << "  #" << i << ": " << FilenameValidator::describe(verdicts[i]) << '\n';
+    }
 }
 
 void FormatDemo::secureFileProcessing(const string& filename) {
+    TRACE_SCOPE("FormatDemo::secureFileProcessing");
     cout << "\n=== SECURE FILE PROCESSING ===\n";
     
     // Validate input
@@ -134,64 +193,79 @@ void FormatDemo::secureFileProcessing(const string& filename) {
     string safeFilename = sanitizeInput(filename);
     cout << "Processing file: " << safeFilename << '\n';
     
-    ifstream file(safeFilename);
-    if (!file) {
+    // Streaming pipeline: read -> sanitize -> "Line N: ..." -> stdout in
+    // bounded memory; the same code handles files of any size
+    SecurePipeline::Options options;
+    options.maxLines = 10;  // Limit output
+    options.scanner = &PatternScanner::defaults();  // Format specifiers and control bytes in the content
+    SecurePipeline pipeline(options);
+
+    cout << "✅ File contents:\n" << flush;
+    if (!pipeline.run(safeFilename)) {
         // ✅ SECURE: Safe error reporting
         cout << "❌ Failed to open file: " << safeFilename << '\n';
         return;
     }
-    
-    string line;
-    int lineNum = 1;
-    cout << "✅ File contents:\n";
-    
-    while (getline(file, line) && lineNum <= 10) {  // Limit output
-        // ✅ SECURE: Safe line output (no format vulnerabilities)
-        cout << "Line " << lineNum << ": " << line << '\n';
-        lineNum++;
+    fflush(stdout);
+
+    auto stats = pipeline.stats();
+    printf("✅ Processed %llu lines from: %s\n", static_cast<unsigned long long>(stats.sink.lines),
+           safeFilename.c_str());
+    if (stats.flaggedLines > 0) {
+        printf("⚠️  %llu lines contained format specifiers or control bytes (sanitized above)\n",
+               static_cast<unsigned long long>(stats.flaggedLines));
     }
-    
-    printf("✅ Processed %d lines from: %s\n", lineNum - 1, safeFilename.c_str());
+}
+
+void FormatDemo::secureDirectoryProcessing(const string& directory) {
+    TRACE_SCOPE("FormatDemo::secureDirectoryProcessing");
+    cout << "\n=== SECURE DIRECTORY PROCESSING ===\n";
+    cout << "Processing directory: " << sanitizeInput(directory) << '\n';
+
+    DirectoryIngest ingest;
+    atomic<size_t> lines{0};
+    auto stats = ingest.run(directory, [&](const string&, string_view contents) {
+        lines.fetch_add(LineScanner::countLines(contents), memory_order_relaxed);
+    });
+
+    printf("✅ Read %zu files, %zu lines, %llu bytes (%s)\n", stats.read, lines.load(),
+           static_cast<unsigned long long>(stats.bytes), BatchFileReader::backendName(stats.backend));
+    if (stats.rejected) printf("❌ %zu invalid filenames skipped\n", stats.rejected);
+    if (stats.failed) printf("❌ %zu files could not be read\n", stats.failed);
 }
 
 bool FormatDemo::isValidFilename(const string& filename) {
-    // Check for empty
-    if (filename.empty()) return false;
-    
-    // Check for path traversal
-    if (filename.find("..") != string::npos) return false;
-    
-    // Check for control characters
-    for (char c : filename) {
-        if (c < 32 && c != '\t') return false;  // No control chars except tab
-    }
-    
-    // Check length
-    if (filename.length() > 255) return false;
-    
-    // Check for format specifiers (basic check)
-    if (filename.find('%') != string::npos) return false;
-    
-    return true;
+    bool valid = filenameAcceptable(filename);
+    if (!valid) TRACE_COUNT(RejectedFilenames, 1);
+    return valid;
 }
 
 string FormatDemo::sanitizeInput(const string& input) {
-    string result = input;
-    
-    // Remove/replace dangerous characters
-    replace(result.begin(), result.end(), '%', '_');
-    replace(result.begin(), result.end(), '\n', '_');
-    replace(result.begin(), result.end(), '\r', '_');
-    
-    // Truncate if too long
-    if (result.length() > 100) {
-        result = result.substr(0, 100);
-    }
-    
+    // Remove/replace dangerous characters and truncate in a single pass
+    string result;
+    sanitizeInto(input, result);
     return result;
 }
 
+size_t FormatDemo::sanitizeInto(string_view input, span<char> out) {
+    size_t length = min({input.size(), maxSanitizedLength, out.size()});
+    SanitizePolicy::transform(input.substr(0, length), out.data());
+    return length;
+}
+
+void FormatDemo::sanitizeInto(string_view input, string& out) {
+    out.resize(min(input.size(), maxSanitizedLength));
+    sanitizeInto(input, span<char>(out.data(), out.size()));
+}
+
+void FormatDemo::sanitizeInPlace(string& text) {
+    // Truncate if too long
+    if (text.size() > maxSanitizedLength) text.resize(maxSanitizedLength);
+    SanitizePolicy::transform(text, text.data());
+}
+
 void FormatDemo::runAllDemos() {
+    TRACE_SCOPE("FormatDemo::runAllDemos");
     cout << "=== FORMAT SECURITY DEMONSTRATION ===\n";
     
     demonstrateFormatVulnerabilities();
@@ -208,6 +282,7 @@ void FormatDemo::runAllDemos() {
 }
 
 void FormatDemo::explainPointerDereference() {
+    TRACE_SCOPE("FormatDemo::explainPointerDereference");
     cout << "\n=== WHY %s CAUSES POINTER DEREFERENCE ===\n";
     
     cout << "🔍 HOW %s WORKS:\n";
@@ -236,6 +311,7 @@ void FormatDemo::explainPointerDereference() {
 }
 
 void FormatDemo::demonstrateStackLayout() {
+    TRACE_SCOPE("FormatDemo::demonstrateStackLayout");
     cout << "\n=== STACK LAYOUT DURING PRINTF ATTACK ===\n";
     
     // Simulate what's on the stack
@@ -261,6 +337,7 @@ void FormatDemo::demonstrateStackLayout() {
 }
 
 void FormatDemo::compareWithOtherSpecifiers() {
+    TRACE_SCOPE("FormatDemo::compareWithOtherSpecifiers");
     cout << "\n=== COMPARISON WITH OTHER FORMAT SPECIFIERS ===\n";
     
     cout << "📊 WHAT DIFFERENT SPECIFIERS DO:\n\n";
@@ -289,6 +366,7 @@ void FormatDemo::compareWithOtherSpecifiers() {
 }
 
 void FormatDemo::showRealWorldPointerAttack() {
+    TRACE_SCOPE("FormatDemo::showRealWorldPointerAttack");
     cout << "\n=== REAL WORLD POINTER DEREFERENCE ATTACK ===\n";
     
     cout << "🎯 HISTORICAL EXAMPLE (wu-ftpd vulnerability):\n";
@@ -1,6 +1,8 @@
 #pragma once
 #include <iostream>
+#include <span>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <cstdio>
 
@@ -16,6 +18,10 @@ public:
     
     // Secure file processing example
     static void secureFileProcessing(const std::string& filename);
+
+    // Batch mode: every validly named file under a directory, read with
+    // many reads in flight
+    static void secureDirectoryProcessing(const std::string& directory);
     
     // Buffer overflow examples
     static void demonstrateBufferIssues();
@@ -38,10 +44,19 @@ public:
     // Show real-world pointer attack
     static void showRealWorldPointerAttack();
 
-private:
-    // Helper functions
+    // Validation helpers (also the reference for the batch validator)
     static bool isValidFilename(const std::string& filename);
     static std::string sanitizeInput(const std::string& input);
+
+    // Allocation-free sanitizing: same result as sanitizeInput, written in
+    // one table-driven pass that also truncates
+    static constexpr size_t maxSanitizedLength = 100;
+    // Into a caller buffer; returns the bytes written (truncated to out.size())
+    static size_t sanitizeInto(std::string_view input, std::span<char> out);
+    // Into a reusable string (no allocation once its capacity suffices)
+    static void sanitizeInto(std::string_view input, std::string& out);
+    // In place (shrinking never reallocates)
+    static void sanitizeInPlace(std::string& text);
 };
 
 } // namespace format_security
\ No newline at end of file
@@ -0,0 +1,375 @@
+#include "PatternScanner.h"
+#include "CharPolicy.h"
+#include "../Files/LineScanner.h"
+
+#include <algorithm>
+#include <bitset>
+#include <deque>
+#include <map>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PATTERNSCANNER_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define PATTERNSCANNER_NEON 1
+#endif
+
+namespace format_security {
+
+namespace {
+
+constexpr size_t kBlock = 64;
+constexpr size_t kMaxStates = 1 << 20;
+
+using ByteSet = std::bitset<256>;
+
+// Bit i set when byte i of the 64-byte block may start a match, looked up
+// in the prefilter's nibble tables
+using CandidateFn = uint64_t (*)(const unsigned char* p, const uint8_t* low, const uint8_t* high);
+
+#ifdef PATTERNSCANNER_X86
+
+__attribute__((target("ssse3")))
+uint64_t candidatesSSSE3(const unsigned char* p, const uint8_t* low, const uint8_t* high) {
+    const __m128i lowTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low));
+    const __m128i highTable = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    uint64_t mask = 0;
+    for (size_t k = 0; k < kBlock; k += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+        __m128i lo = _mm_shuffle_epi8(lowTable, _mm_and_si128(v, nibble));
+        __m128i hi = _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i none = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(none)) ^ 0xffffu) << k;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+uint64_t candidatesAVX2(const unsigned char* p, const uint8_t* low, const uint8_t* high) {
+    const __m256i lowTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low)));
+    const __m256i highTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(high)));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    uint64_t mask = 0;
+    for (size_t k = 0; k < kBlock; k += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + k));
+        __m256i lo = _mm256_shuffle_epi8(lowTable, _mm256_and_si256(v, nibble));
+        __m256i hi = _mm256_shuffle_epi8(highTable, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i none = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+        mask |= static_cast<uint64_t>(~static_cast<uint32_t>(_mm256_movemask_epi8(none))) << k;
+    }
+    return mask;
+}
+
+#endif // PATTERNSCANNER_X86
+
+#ifdef PATTERNSCANNER_NEON
+
+// 16 compare lanes -> 16-bit movemask
+inline uint64_t neonMovemask(uint8x16_t cmp) {
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(cmp, vld1q_u8(weights));
+    return vaddv_u8(vget_low_u8(bits)) | (static_cast<uint64_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+}
+
+uint64_t candidatesNEON(const unsigned char* p, const uint8_t* low, const uint8_t* high) {
+    const uint8x16_t lowTable = vld1q_u8(low), highTable = vld1q_u8(high);
+    uint64_t mask = 0;
+    for (size_t k = 0; k < kBlock; k += 16) {
+        uint8x16_t v = vld1q_u8(p + k);
+        uint8x16_t lo = vqtbl1q_u8(lowTable, vandq_u8(v, vdupq_n_u8(0x0f)));
+        uint8x16_t hi = vqtbl1q_u8(highTable, vshrq_n_u8(v, 4));
+        mask |= neonMovemask(vtstq_u8(lo, hi)) << k;
+    }
+    return mask;
+}
+
+#endif // PATTERNSCANNER_NEON
+
+CandidateFn selectKernel() {
+#ifdef PATTERNSCANNER_X86
+    if (__builtin_cpu_supports("avx2")) return candidatesAVX2;
+    if (__builtin_cpu_supports("ssse3")) return candidatesSSSE3;
+    return nullptr;
+#elif defined(PATTERNSCANNER_NEON)
+    return candidatesNEON;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace
+
+PatternScanner::PatternScanner(const std::vector<std::string>& patterns) : PatternScanner(patterns, Options{}) {}
+
+PatternScanner::PatternScanner(const std::vector<std::string>& patterns, Options options) : patterns_(patterns) {
+    // Every pattern position as the set of bytes it accepts
+    std::vector<std::vector<ByteSet>> sequences;
+    for (const std::string& pattern : patterns_) {
+        if (pattern.empty()) throw std::invalid_argument("PatternScanner: empty pattern");
+        std::vector<ByteSet> sequence;
+        for (char c : pattern) {
+            unsigned b = static_cast<unsigned char>(c);
+            ByteSet set;
+            set.set(b);
+            if (options.caseInsensitive && ((b | 0x20) >= 'a' && (b | 0x20) <= 'z')) set.set(b ^ 0x20);
+            sequence.push_back(set);
+        }
+        sequences.push_back(std::move(sequence));
+        lengths_.push_back(static_cast<uint32_t>(pattern.size()));
+    }
+    lengths_.push_back(1);  // The control pseudo-pattern
+    if (options.controlBytes) {
+        ByteSet control;
+        for (unsigned b = 0; b < 256; ++b) control[b] = ContentControlPolicy::table.classes[b] & kControlClass;
+        sequences.push_back({control});
+    }
+
+    // Byte classes: bytes that belong to exactly the same position sets are
+    // interchangeable. Bytes in none of them form class 0.
+    std::vector<ByteSet> distinct;
+    for (const auto& sequence : sequences) {
+        for (const ByteSet& set : sequence) {
+            if (std::find(distinct.begin(), distinct.end(), set) == distinct.end()) distinct.push_back(set);
+        }
+    }
+    std::map<std::vector<bool>, uint8_t> classIds{{std::vector<bool>(distinct.size(), false), 0}};
+    std::vector<unsigned> representative{0};
+    for (unsigned b = 0; b < 256; ++b) {
+        std::vector<bool> signature(distinct.size());
+        for (size_t i = 0; i < distinct.size(); ++i) signature[i] = distinct[i][b];
+        auto it = classIds.find(signature);
+        if (it == classIds.end()) {
+            // 256 bytes plus the reserved empty class could overflow the ids
+            if (classIds.size() == 256) throw std::invalid_argument("PatternScanner: too many byte classes");
+            it = classIds.emplace(signature, static_cast<uint8_t>(classIds.size())).first;
+            representative.push_back(b);
+        }
+        classOf_[b] = it->second;
+    }
+    classes_ = static_cast<uint32_t>(representative.size());
+
+    // Trie over classes; a position accepting several classes branches
+    struct Node {
+        std::vector<int32_t> edge;
+        std::vector<uint32_t> out;
+        uint32_t fail = 0;
+    };
+    std::vector<Node> nodes(1);
+    nodes[0].edge.assign(classes_, -1);
+    auto insert = [&](auto&& self, uint32_t node, const std::vector<ByteSet>& sequence, size_t depth,
+                      uint32_t id) -> void {
+        if (depth == sequence.size()) {
+            nodes[node].out.push_back(id);
+            return;
+        }
+        for (uint32_t c = 1; c < classes_; ++c) {
+            if (!sequence[depth][representative[c]]) continue;
+            if (nodes[node].edge[c] < 0) {
+                if (nodes.size() >= kMaxStates) throw std::invalid_argument("PatternScanner: too many states");
+                nodes[node].edge[c] = static_cast<int32_t>(nodes.size());
+                nodes.push_back(Node{std::vector<int32_t>(classes_, -1), {}, 0});
+            }
+            self(self, static_cast<uint32_t>(nodes[node].edge[c]), sequence, depth + 1, id);
+        }
+    };
+    for (size_t id = 0; id < sequences.size(); ++id) insert(insert, 0, sequences[id], 0, static_cast<uint32_t>(id));
+
+    // Failure links in BFS order, turning the trie into a complete DFA
+    std::vector<uint32_t> order;
+    std::deque<uint32_t> queue;
+    for (uint32_t c = 0; c < classes_; ++c) {
+        int32_t child = nodes[0].edge[c];
+        if (child < 0) {
+            nodes[0].edge[c] = 0;
+        } else {
+            queue.push_back(static_cast<uint32_t>(child));
+        }
+    }
+    order.push_back(0);
+    while (!queue.empty()) {
+        uint32_t u = queue.front();
+        queue.pop_front();
+        order.push_back(u);
+        const Node& failNode = nodes[nodes[u].fail];
+        if (!failNode.out.empty()) nodes[u].out.insert(nodes[u].out.end(), failNode.out.begin(), failNode.out.end());
+        for (uint32_t c = 0; c < classes_; ++c) {
+            int32_t child = nodes[u].edge[c];
+            int32_t viaFail = nodes[nodes[u].fail].edge[c];
+            if (child < 0) {
+                nodes[u].edge[c] = viaFail;
+            } else {
+                nodes[static_cast<size_t>(child)].fail = static_cast<uint32_t>(viaFail);
+                queue.push_back(static_cast<uint32_t>(child));
+            }
+        }
+    }
+
+    // Renumber: states without outputs first (root stays 0), so "has a
+    // match" is one compare against acceptRow_ in the scan loop
+    std::vector<uint32_t> renumbered(nodes.size());
+    uint32_t plain = 0;
+    for (uint32_t u : order) {
+        if (nodes[u].out.empty()) renumbered[u] = plain++;
+    }
+    uint32_t accepting = plain;
+    outputStart_.push_back(0);
+    for (uint32_t u : order) {
+        if (nodes[u].out.empty()) continue;
+        renumbered[u] = accepting++;
+        outputs_.insert(outputs_.end(), nodes[u].out.begin(), nodes[u].out.end());
+        outputStart_.push_back(static_cast<uint32_t>(outputs_.size()));
+    }
+    // Outputs were appended in BFS order, which is also the accepting order
+    acceptRow_ = plain * classes_;
+    next_.assign(static_cast<size_t>(nodes.size()) * classes_, 0);
+    for (uint32_t u = 0; u < nodes.size(); ++u) {
+        for (uint32_t c = 0; c < classes_; ++c) {
+            next_[static_cast<size_t>(renumbered[u]) * classes_ + c] =
+                renumbered[static_cast<size_t>(nodes[u].edge[c])] * classes_;
+        }
+    }
+
+    // Prefilter: which bytes leave the root state, as one low-nibble set
+    // per high nibble. High nibbles with the same set share a bucket bit.
+    std::array<uint16_t, 16> lowSets{};
+    for (unsigned b = 0; b < 256; ++b) {
+        startsMatch_[b] = next_[classOf_[b]] != 0;
+        if (startsMatch_[b]) lowSets[b >> 4] |= static_cast<uint16_t>(1u << (b & 15));
+    }
+    std::vector<uint16_t> buckets;
+    for (uint16_t set : lowSets) {
+        if (set && std::find(buckets.begin(), buckets.end(), set) == buckets.end()) buckets.push_back(set);
+    }
+    // More than 8 distinct sets: fold the extras into the last bucket (a
+    // superset only adds candidates the automaton then rejects)
+    while (buckets.size() > 8) {
+        uint16_t folded = buckets.back();
+        buckets.pop_back();
+        for (uint16_t& set : lowSets) {
+            if (set == folded || set == buckets.back()) set = static_cast<uint16_t>(folded | buckets.back());
+        }
+        buckets.back() |= folded;
+    }
+    for (unsigned h = 0; h < 16; ++h) {
+        if (!lowSets[h]) continue;
+        size_t bucket = static_cast<size_t>(std::find(buckets.begin(), buckets.end(), lowSets[h]) - buckets.begin());
+        prefilter_.high[h] |= static_cast<uint8_t>(1u << bucket);
+        for (unsigned l = 0; l < 16; ++l) {
+            if (lowSets[h] & (1u << l)) prefilter_.low[l] |= static_cast<uint8_t>(1u << bucket);
+        }
+    }
+    prefilter_.usable = selectKernel() != nullptr;
+}
+
+const std::vector<std::string>& PatternScanner::formatSpecifiers() {
+    static const std::vector<std::string> specifiers{"%n", "%hn", "%hhn", "%ln", "%lln", "%s", "%x", "%X", "%p"};
+    return specifiers;
+}
+
+const PatternScanner& PatternScanner::defaults() {
+    static const PatternScanner scanner(formatSpecifiers());
+    return scanner;
+}
+
+std::string_view PatternScanner::describe(uint32_t pattern) const {
+    if (pattern < patterns_.size()) return patterns_[pattern];
+    return "control byte";
+}
+
+template <typename OnMatch>
+void PatternScanner::scan(std::string_view text, OnMatch&& onMatch) const {
+    static const CandidateFn candidates = selectKernel();
+
+    const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t n = text.size();
+    const uint32_t* next = next_.data();
+    const uint8_t* classOf = classOf_.data();
+
+    // Candidate mask of the block starting at blockPos, reused while the
+    // scan stays inside it
+    size_t blockPos = n;
+    uint64_t mask = 0;
+    auto nextCandidate = [&](size_t pos) {
+        if (!prefilter_.usable) {
+            while (pos < n && !startsMatch_[p[pos]]) ++pos;
+            return pos;
+        }
+        for (;;) {
+            if (pos >= blockPos && pos < blockPos + kBlock) {
+                uint64_t rest = mask & (~uint64_t{0} << (pos - blockPos));
+                if (rest) return blockPos + static_cast<size_t>(__builtin_ctzll(rest));
+                pos = blockPos + kBlock;
+            }
+            if (pos + kBlock > n) {
+                while (pos < n && !startsMatch_[p[pos]]) ++pos;
+                return pos;
+            }
+            blockPos = pos;
+            mask = candidates(p + pos, prefilter_.low.data(), prefilter_.high.data());
+        }
+    };
+
+    uint32_t row = 0;
+    for (size_t pos = 0; pos < n; ++pos) {
+        if (row == 0) {
+            pos = nextCandidate(pos);
+            if (pos >= n) return;
+        }
+        row = next[row + classOf[p[pos]]];
+        if (row >= acceptRow_) {
+            size_t state = (row - acceptRow_) / classes_;
+            for (uint32_t k = outputStart_[state]; k < outputStart_[state + 1]; ++k) {
+                if (!onMatch(pos, outputs_[k])) return;
+            }
+        }
+    }
+}
+
+bool PatternScanner::containsAny(std::string_view text) const {
+    bool found = false;
+    scan(text, [&](size_t, uint32_t) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+size_t PatternScanner::findAll(std::string_view text, std::vector<PatternMatch>& out) const {
+    size_t before = out.size();
+    scan(text, [&](size_t end, uint32_t id) {
+        out.push_back({end + 1 - lengths_[id], id});
+        return true;
+    });
+    return out.size() - before;
+}
+
+size_t PatternScanner::flagLines(std::string_view text, std::vector<FlaggedLine>& out) const {
+    size_t before = out.size();
+    size_t line = 0, lineStart = 0, cursor = 0;
+    scan(text, [&](size_t end, uint32_t id) {
+        // Newlines passed since the previous match move the line forward
+        size_t start = end + 1 - lengths_[id];
+        if (start > cursor) {
+            std::string_view gap = text.substr(cursor, start - cursor);
+            // countLines (vectorized) also counts an unterminated tail
+            size_t newlines = LineScanner::countLines(gap) - (gap.back() != '\n');
+            if (newlines) {
+                line += newlines;
+                lineStart = cursor + gap.rfind('\n') + 1;
+            }
+            cursor = start;
+        }
+        if (out.size() > before && out.back().line == line) {
+            ++out.back().matches;
+        } else {
+            out.push_back({line, lineStart, id, 1});
+        }
+        return true;
+    });
+    return out.size() - before;
+}
+
+} // namespace format_security
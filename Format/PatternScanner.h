@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace format_security {
+
+// One occurrence: offset of its first byte and the pattern's id
+struct PatternMatch {
+    size_t offset;
+    uint32_t pattern;
+};
+
+// A line with at least one match (line numbers count from 0)
+struct FlaggedLine {
+    size_t line;
+    size_t offset;          // Start of the line in the scanned text
+    uint32_t firstPattern;  // Pattern of the first match on the line
+    uint32_t matches;
+};
+
+// Content counterpart of FormatDemo::isValidFilename: finds many literal
+// patterns (printf conversions, configurable markers) and control bytes in
+// one pass over a whole buffer.
+//
+// The patterns compile into an Aho-Corasick automaton over byte classes
+// (bytes no pattern distinguishes share a column), stored as a flat
+// transition table. While the automaton sits in its root state, a SIMD
+// prefilter skips 64 bytes at a time to the next byte that can start a
+// match: two 16-entry nibble tables classify any byte set in one shuffle
+// each (AVX2, SSSE3 or NEON; scalar otherwise), so ordinary text costs
+// little more than a memchr.
+class PatternScanner {
+public:
+    struct Options {
+        // Report bytes 0x00-0x1f (except tab, LF, CR) and 0x7f
+        bool controlBytes = true;
+        // ASCII letters match either case
+        bool caseInsensitive = false;
+    };
+
+    // Patterns must be non-empty; ids are their positions in the vector
+    explicit PatternScanner(const std::vector<std::string>& patterns);
+    PatternScanner(const std::vector<std::string>& patterns, Options options);
+
+    // printf conversions that read or write through a pointer argument:
+    // %n %hn %hhn %ln %lln %s %x %X %p
+    static const std::vector<std::string>& formatSpecifiers();
+    // formatSpecifiers() plus control bytes, built once
+    static const PatternScanner& defaults();
+
+    size_t patternCount() const { return patterns_.size(); }
+    // Id reported for control bytes (one past the last pattern)
+    uint32_t controlPattern() const { return static_cast<uint32_t>(patterns_.size()); }
+    // The pattern text, or "control byte"
+    std::string_view describe(uint32_t pattern) const;
+
+    bool containsAny(std::string_view text) const;
+    // Appends every match, overlapping ones included, in order of their
+    // last byte; returns how many were appended
+    size_t findAll(std::string_view text, std::vector<PatternMatch>& out) const;
+    // Appends one entry per line ('\n'-separated) with a match; returns how
+    // many were appended
+    size_t flagLines(std::string_view text, std::vector<FlaggedLine>& out) const;
+
+    // Whether the prefilter runs vectorized on this CPU
+    bool vectorized() const { return prefilter_.usable; }
+
+private:
+    // Byte b may start a match when low[b & 15] & high[b >> 4] is non-zero
+    // (exact for up to 8 distinct low-nibble sets, a superset beyond)
+    struct Prefilter {
+        bool usable = false;
+        std::array<uint8_t, 16> low{};
+        std::array<uint8_t, 16> high{};
+    };
+
+    template <typename OnMatch>
+    void scan(std::string_view text, OnMatch&& onMatch) const;
+
+    std::vector<std::string> patterns_;
+    std::vector<uint32_t> lengths_;            // Per id, including the control pseudo-pattern
+    std::array<uint8_t, 256> classOf_{};
+    std::array<bool, 256> startsMatch_{};
+    uint32_t classes_ = 1;
+    std::vector<uint32_t> next_;               // [row + class] -> next row (row = state * classes_)
+    uint32_t acceptRow_ = 0;                   // Rows from here on have outputs
+    std::vector<uint32_t> outputStart_;        // Per accepting state, into outputs_
+    std::vector<uint32_t> outputs_;
+    Prefilter prefilter_;
+};
+
+} // namespace format_security
@@ -0,0 +1,141 @@
+#include "SafeFormat.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace format_security {
+
+namespace detail {
+
+void formatStringError(const char*) {
+    // Only ever called at compile time, where calling it fails the build
+}
+
+} // namespace detail
+
+namespace {
+
+// Bounded output cursor that keeps counting past the end
+class Writer {
+public:
+    explicit Writer(std::span<char> out) : out_(out) {}
+
+    void put(char c) {
+        if (size_ < out_.size()) out_[size_] = c;
+        ++size_;
+    }
+
+    void put(std::string_view text) {
+        if (size_ < out_.size()) {
+            size_t room = out_.size() - size_;
+            std::memcpy(out_.data() + size_, text.data(), text.size() < room ? text.size() : room);
+        }
+        size_ += text.size();
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    std::span<char> out_;
+    size_t size_ = 0;
+};
+
+template <typename T>
+void putNumber(Writer& w, T value, int base = 10, bool upper = false) {
+    char digits[32];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, base);
+    if (upper) {
+        for (char* p = digits; p != end; ++p) {
+            if (*p >= 'a' && *p <= 'f') *p = static_cast<char>(*p - 'a' + 'A');
+        }
+    }
+    w.put(std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+void putFloat(Writer& w, double value, int precision) {
+    char digits[512];
+    auto [end, ec] = precision < 0
+        ? std::to_chars(digits, digits + sizeof(digits), value)
+        : std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    if (ec != std::errc()) {
+        w.put("<float>");
+        return;
+    }
+    w.put(std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+void putArg(Writer& w, const FormatArg& arg, std::string_view spec) {
+    // Spec was validated against the argument kind at compile time
+    bool hex = spec == "x" || spec == "X";
+    int precision = -1;
+    if (!spec.empty() && spec[0] == '.') {
+        precision = 0;
+        for (size_t i = 1; i < spec.size() && spec[i] >= '0' && spec[i] <= '9'; ++i) {
+            precision = precision * 10 + (spec[i] - '0');
+        }
+    }
+
+    switch (arg.kind) {
+        case FormatArgKind::Signed:
+            if (hex) putNumber(w, static_cast<unsigned long long>(arg.i), 16, spec == "X");
+            else putNumber(w, arg.i);
+            break;
+        case FormatArgKind::Unsigned:
+            putNumber(w, arg.u, hex ? 16 : 10, spec == "X");
+            break;
+        case FormatArgKind::Float:
+            putFloat(w, arg.d, precision);
+            break;
+        case FormatArgKind::String: {
+            size_t size = arg.s.size;
+            if (precision >= 0 && static_cast<size_t>(precision) < size) size = static_cast<size_t>(precision);
+            w.put(std::string_view(arg.s.data, size));
+            break;
+        }
+        case FormatArgKind::Char:
+            w.put(arg.c);
+            break;
+        case FormatArgKind::Bool:
+            w.put(arg.b ? std::string_view("true") : std::string_view("false"));
+            break;
+        case FormatArgKind::Pointer:
+            w.put("0x");
+            putNumber(w, reinterpret_cast<uintptr_t>(arg.p), 16);
+            break;
+    }
+}
+
+} // namespace
+
+size_t detail::vformatTo(std::span<char> out, std::string_view format, const FormatArg* args, size_t count) {
+    Writer w(out);
+    size_t next = 0;
+    size_t literal = 0;  // Start of the pending literal run
+
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if (c != '{' && c != '}') continue;
+
+        w.put(format.substr(literal, i - literal));
+        if (i + 1 < format.size() && format[i + 1] == c) {  // "{{" or "}}"
+            w.put(c);
+            ++i;
+        } else if (c == '}') {
+            w.put(c);  // Lone '}': CheckedFormat rejects it, keep it literal
+        } else {
+            size_t close = format.find('}', i);
+            if (close == std::string_view::npos) {
+                literal = i;  // Unmatched '{': the rest is literal text
+                break;
+            }
+            std::string_view inner = format.substr(i + 1, close - i - 1);
+            if (next < count) putArg(w, args[next++], inner.empty() ? inner : inner.substr(1));
+            i = close;
+        }
+        literal = i + 1;
+    }
+    w.put(format.substr(literal));
+    return w.size();
+}
+
+} // namespace format_security
@@ -0,0 +1,200 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace format_security {
+
+// Compile-time checked formatting into caller or stack buffers.
+//
+//   char buf[64];
+//   size_t n = formatTo(buf, "File: {}, Lines: {}, Size: {:.1f} KB", name, lines, size);
+//
+// The format must be a string literal: it is parsed by a consteval
+// constructor, so a runtime (user-controlled) string does not compile, and
+// neither does a placeholder/argument count or type mismatch.
+//
+// Placeholders: {} any argument, {:x}/{:X} hex integer, {:.N} string cut to
+// N chars (like %.Ns), {:.Nf} fixed float with N decimals. {{ and }} are
+// literal braces. Output is truncated, never overrun.
+
+enum class FormatArgKind : uint8_t { Signed, Unsigned, Float, String, Char, Bool, Pointer };
+
+// Type-erased argument; formatting runs in one non-template function
+struct FormatArg {
+    FormatArgKind kind;
+    union {
+        long long i;
+        unsigned long long u;
+        double d;
+        char c;
+        bool b;
+        const void* p;
+        struct {
+            const char* data;
+            size_t size;
+        } s;
+    };
+};
+
+namespace detail {
+
+template <typename T>
+consteval FormatArgKind argKind() {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, bool>) return FormatArgKind::Bool;
+    else if constexpr (std::is_same_v<U, char>) return FormatArgKind::Char;
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) return FormatArgKind::Signed;
+    else if constexpr (std::is_integral_v<U>) return FormatArgKind::Unsigned;
+    else if constexpr (std::is_floating_point_v<U>) return FormatArgKind::Float;
+    else if constexpr (std::is_convertible_v<const U&, std::string_view>) return FormatArgKind::String;
+    else if constexpr (std::is_pointer_v<U>) return FormatArgKind::Pointer;
+    else static_assert(sizeof(U) == 0, "unsupported argument type for formatTo");
+}
+
+template <typename T>
+FormatArg makeArg(const T& value) {
+    FormatArg arg;
+    arg.kind = argKind<T>();
+    if constexpr (argKind<T>() == FormatArgKind::Bool) arg.b = value;
+    else if constexpr (argKind<T>() == FormatArgKind::Char) arg.c = value;
+    else if constexpr (argKind<T>() == FormatArgKind::Signed) arg.i = value;
+    else if constexpr (argKind<T>() == FormatArgKind::Unsigned) arg.u = value;
+    else if constexpr (argKind<T>() == FormatArgKind::Float) arg.d = static_cast<double>(value);
+    else if constexpr (argKind<T>() == FormatArgKind::String) {
+        std::string_view sv = value;
+        arg.s = {sv.data(), sv.size()};
+    } else arg.p = static_cast<const void*>(value);
+    return arg;
+}
+
+// Not constexpr: reaching it during consteval parsing is the compile error
+void formatStringError(const char* reason);
+
+// Checks one "{...}" spec (text between ':' and '}') against an argument kind
+consteval void checkSpec(std::string_view spec, FormatArgKind kind) {
+    if (spec.empty()) return;
+    if (spec == "x" || spec == "X") {
+        if (kind != FormatArgKind::Signed && kind != FormatArgKind::Unsigned)
+            formatStringError("{:x} needs an integer argument");
+        return;
+    }
+    if (spec[0] != '.' || spec.size() < 2) formatStringError("unknown format spec");
+    size_t digits = 1;
+    while (digits < spec.size() && spec[digits] >= '0' && spec[digits] <= '9') ++digits;
+    if (digits == 1) formatStringError("precision needs digits");
+    std::string_view rest = spec.substr(digits);
+    if (rest == "f") {
+        if (kind != FormatArgKind::Float) formatStringError("{:.Nf} needs a floating-point argument");
+    } else if (rest.empty()) {
+        if (kind != FormatArgKind::String && kind != FormatArgKind::Float)
+            formatStringError("{:.N} needs a string or floating-point argument");
+    } else {
+        formatStringError("unknown format spec");
+    }
+}
+
+// Formatting engine behind formatTo. Only for formats that passed
+// CheckedFormat (or were stored from one, as AsyncLogger does); other text
+// is handled without reading out of bounds but is not rejected. Returns
+// the untruncated length, like snprintf; at most out.size() bytes are
+// written.
+size_t vformatTo(std::span<char> out, std::string_view format, const FormatArg* args, size_t count);
+
+} // namespace detail
+
+template <typename... Args>
+class CheckedFormat {
+public:
+    template <typename S>
+        requires std::is_convertible_v<const S&, std::string_view>
+    consteval CheckedFormat(const S& text) : text_(text) {
+        constexpr FormatArgKind kinds[] = {detail::argKind<Args>()..., FormatArgKind::Bool};
+        size_t next = 0;
+        for (size_t i = 0; i < text_.size(); ++i) {
+            char c = text_[i];
+            if (c == '}') {
+                if (i + 1 >= text_.size() || text_[i + 1] != '}') detail::formatStringError("unmatched '}'");
+                ++i;
+            } else if (c == '{') {
+                if (i + 1 < text_.size() && text_[i + 1] == '{') {
+                    ++i;
+                    continue;
+                }
+                size_t close = text_.find('}', i);
+                if (close == std::string_view::npos) detail::formatStringError("unterminated '{'");
+                std::string_view inner = text_.substr(i + 1, close - i - 1);
+                if (!inner.empty() && inner[0] != ':') detail::formatStringError("only {} and {:spec} are supported");
+                if (next >= sizeof...(Args)) detail::formatStringError("more placeholders than arguments");
+                detail::checkSpec(inner.empty() ? inner : inner.substr(1), kinds[next++]);
+                i = close;
+            }
+        }
+        if (next != sizeof...(Args)) detail::formatStringError("more arguments than placeholders");
+    }
+
+    constexpr std::string_view get() const { return text_; }
+
+private:
+    std::string_view text_;
+};
+
+// Blocks Args deduction from the format parameter
+template <typename... Args>
+using FormatString = CheckedFormat<std::type_identity_t<Args>...>;
+
+// Writes into `out` without a terminator; returns the bytes written
+template <typename... Args>
+size_t formatTo(std::span<char> out, FormatString<Args...> format, const Args&... args) {
+    const FormatArg packed[] = {detail::makeArg(args)..., FormatArg{FormatArgKind::Bool, {}}};
+    size_t needed = detail::vformatTo(out, format.get(), packed, sizeof...(Args));
+    return needed < out.size() ? needed : out.size();
+}
+
+// Fixed-capacity, stack-resident formatting result
+template <size_t Capacity>
+class FormatBuffer {
+public:
+    std::string_view view() const { return {data_, size_}; }
+    const char* c_str() const { return data_; }
+    size_t size() const { return size_; }
+    bool truncated() const { return truncated_; }
+    operator std::string_view() const { return view(); }
+
+    template <size_t N, typename... Args>
+    friend FormatBuffer<N> formatFixed(FormatString<Args...> format, const Args&... args);
+
+private:
+    char data_[Capacity + 1];  // Room for a terminator, for C APIs
+    size_t size_ = 0;
+    bool truncated_ = false;
+};
+
+// Formats into a stack buffer: auto msg = formatFixed<128>("{} lines", n);
+template <size_t N = 256, typename... Args>
+FormatBuffer<N> formatFixed(FormatString<Args...> format, const Args&... args) {
+    FormatBuffer<N> result;
+    const FormatArg packed[] = {detail::makeArg(args)..., FormatArg{FormatArgKind::Bool, {}}};
+    size_t needed = detail::vformatTo(std::span<char>(result.data_, N), format.get(), packed, sizeof...(Args));
+    result.size_ = needed < N ? needed : N;
+    result.truncated_ = needed > N;
+    result.data_[result.size_] = '\0';
+    return result;
+}
+
+// Heap result, for when a std::string is wanted anyway
+template <typename... Args>
+std::string formatString(FormatString<Args...> format, const Args&... args) {
+    const FormatArg packed[] = {detail::makeArg(args)..., FormatArg{FormatArgKind::Bool, {}}};
+    char stack[256];
+    size_t needed = detail::vformatTo(stack, format.get(), packed, sizeof...(Args));
+    if (needed <= sizeof(stack)) return std::string(stack, needed);
+    std::string result(needed, '\0');
+    detail::vformatTo(result, format.get(), packed, sizeof...(Args));
+    return result;
+}
+
+} // namespace format_security
@@ -0,0 +1,409 @@
+#include "SecurePipeline.h"
+#include "CharPolicy.h"
+#include "PatternScanner.h"
+#include "../Logging/Trace.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <thread>
+
+namespace format_security {
+
+namespace {
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void atomicMax(std::atomic<size_t>& target, size_t value) {
+    size_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// secureFileProcessing's line format
+void lineNumberTransform(size_t lineNumber, std::string_view line, std::string& out) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), lineNumber);
+    out.append("Line ");
+    out.append(digits, result.ptr);
+    out.append(": ");
+    out.append(line);
+    out.push_back('\n');
+}
+
+bool stdoutSink(std::string_view output) {
+    return std::fwrite(output.data(), 1, output.size(), stdout) == output.size();
+}
+
+} // namespace
+
+// Storage reused for the whole run: the reader fills text, the validator
+// sanitizes it in place and records the lines, the transformer fills output
+struct SecurePipeline::Batch {
+    explicit Batch(size_t capacity) : text(std::make_unique<char[]>(capacity)), capacity(capacity) {}
+
+    std::unique_ptr<char[]> text;
+    size_t capacity;
+    size_t used = 0;
+    std::vector<LineSpan> lines;
+    size_t firstLine = 1;
+    std::string output;
+    bool last = false;  // End of input; every stage forwards it, then exits
+};
+
+SecurePipeline::SecurePipeline() : SecurePipeline(Options{}) {}
+
+// Enough batches to fill all three queues with one more in each stage, so
+// the reader only waits on free_ when the whole pipeline is backed up
+SecurePipeline::SecurePipeline(Options options)
+    : options_(options),
+      transform_(lineNumberTransform),
+      sink_(stdoutSink),
+      free_(options.queueDepth * 3 + 4),
+      toValidate_(options.queueDepth),
+      toTransform_(options.queueDepth),
+      toSink_(options.queueDepth) {
+    options_.batchBytes = std::max<size_t>(options_.batchBytes, 64);
+    for (size_t i = 0; i < options.queueDepth * 3 + 4; ++i) {
+        batches_.push_back(std::make_unique<Batch>(options_.batchBytes));
+        free_.push(batches_.back().get());
+    }
+}
+
+SecurePipeline::~SecurePipeline() = default;
+
+void SecurePipeline::setTransform(Transform transform) {
+    transform_ = std::move(transform);
+}
+
+void SecurePipeline::setSink(Sink sink) {
+    sink_ = std::move(sink);
+}
+
+bool SecurePipeline::run(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+    run(file);
+    return true;
+}
+
+void SecurePipeline::run(std::istream& input) {
+    TRACE_SCOPE("SecurePipeline::run");
+    resetCounters();
+    stop_ = false;
+    failed_ = false;
+    error_ = nullptr;
+
+    uint64_t start = nowNs();
+    std::thread validateThread([this] { validator(); });
+    std::thread transformThread([this] { transformer(); });
+    std::thread sinkThread([this] { sinker(); });
+    reader(input);
+    validateThread.join();
+    transformThread.join();
+    sinkThread.join();
+    elapsedNs_ = nowNs() - start;
+
+    if (error_) std::rethrow_exception(error_);
+}
+
+void SecurePipeline::forward(Queue& queue, QueueCounters& counters, StageCounters& stage, Batch* batch) {
+    if (!queue.tryPush(batch)) {
+        counters.fullWaits.fetch_add(1, std::memory_order_relaxed);
+        uint64_t start = nowNs();
+        queue.push(batch);
+        stage.blockedNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+    }
+    atomicMax(counters.maxDepth, queue.size());
+}
+
+void SecurePipeline::fail(std::exception_ptr error) {
+    bool expected = false;
+    if (failed_.compare_exchange_strong(expected, true)) error_ = error;
+    stop_ = true;
+}
+
+void SecurePipeline::reader(std::istream& input) {
+    std::streambuf* source = input.rdbuf();
+    std::string carry;      // Partial last line, moved to the next batch
+    bool skipping = false;  // Dropping the rest of a line that filled a batch
+    bool cutCounted = false;
+    bool eof = source == nullptr;
+
+    while (true) {
+        Batch* batch = free_.pop();
+        TRACE_SCOPE("SecurePipeline::read batch");
+        uint64_t start = nowNs();
+        std::memcpy(batch->text.get(), carry.data(), carry.size());
+        batch->used = carry.size();
+        carry.clear();
+
+        while (!eof && batch->used < batch->capacity && !stop_.load(std::memory_order_relaxed)) {
+            char* at = batch->text.get() + batch->used;
+            std::streamsize got = source->sgetn(at, static_cast<std::streamsize>(batch->capacity - batch->used));
+            if (got <= 0) {
+                eof = true;
+                break;
+            }
+            size_t n = static_cast<size_t>(got);
+            if (skipping) {
+                char* newline = static_cast<char*>(std::memchr(at, '\n', n));
+                if (newline != at && !cutCounted) {
+                    cutLines_.fetch_add(1, std::memory_order_relaxed);
+                    cutCounted = true;
+                }
+                if (!newline) continue;
+                size_t rest = n - static_cast<size_t>(newline + 1 - at);
+                std::memmove(at, newline + 1, rest);
+                n = rest;
+                skipping = false;
+            }
+            batch->used += n;
+        }
+        if (stop_.load(std::memory_order_relaxed)) eof = true;
+
+        if (!eof) {
+            // Full batch: ship complete lines, carry the partial one
+            std::string_view text(batch->text.get(), batch->used);
+            size_t newline = text.rfind('\n');
+            if (newline != std::string_view::npos) {
+                size_t keep = newline + 1;
+                carry.assign(text.substr(keep));
+                batch->used = keep;
+            } else {
+                // A line that fills a whole batch: ship it, drop the rest
+                skipping = true;
+                cutCounted = false;
+            }
+        }
+        batch->last = eof;
+
+        TRACE_COUNT(BytesRead, batch->used);
+        read_.bytes.fetch_add(batch->used, std::memory_order_relaxed);
+        read_.batches.fetch_add(1, std::memory_order_relaxed);
+        read_.busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+        forward(toValidate_, toValidateCounters_, read_, batch);
+        if (eof) return;
+    }
+}
+
+void SecurePipeline::validator() {
+    size_t nextLine = 1;
+    const size_t limit = options_.maxLines;
+    constexpr size_t kSpans = 256;
+    LineSpan spans[kSpans];
+    std::vector<FlaggedLine> flags;
+
+    while (true) {
+        Batch* batch = toValidate_.pop();
+        TRACE_SCOPE("SecurePipeline::validate batch");
+        uint64_t start = nowNs();
+        batch->lines.clear();
+        batch->firstLine = nextLine;
+
+        // Past the line limit or after a failure, batches still flow (so
+        // they get back to the reader) but carry no lines
+        size_t written = 0;
+        uint64_t sanitized = 0;
+        char* text = batch->text.get();
+        // Keep a '\r' before '\n' in the line, as getline did, so the
+        // sanitizer replaces it
+        LineScanner scanner(std::string_view(text, batch->used), false);
+        bool full = stop_.load(std::memory_order_relaxed);
+
+        // Content scan of the raw batch before sanitizing rewrites it
+        flags.clear();
+        if (options_.scanner && !full) options_.scanner->flagLines(std::string_view(text, batch->used), flags);
+        while (!full) {
+            size_t count = scanner.nextBatch(spans, kSpans);
+            if (count == 0) break;
+            for (size_t i = 0; i < count; ++i) {
+                if (limit && nextLine + batch->lines.size() > limit) {
+                    stop_ = true;
+                    full = true;
+                    break;
+                }
+                std::string_view line = scanner.line(spans[i]);
+                if (std::memchr(line.data(), '%', line.size()) || std::memchr(line.data(), '\r', line.size())) {
+                    ++sanitized;
+                }
+                // sanitizeInput's byte rewrite without its filename-sized
+                // length cap: content lines are kept whole. Lines only move
+                // left as they compact, so this works in place.
+                SanitizePolicy::transform(line, text + written);
+                batch->lines.push_back({written, line.size()});
+                written += line.size();
+            }
+        }
+        nextLine += batch->lines.size();
+
+        // Lines past a maxLines cut were scanned but are not counted
+        uint64_t flagged = 0;
+        for (const FlaggedLine& flag : flags) flagged += flag.line < batch->lines.size();
+        flaggedLines_.fetch_add(flagged, std::memory_order_relaxed);
+        sanitizedLines_.fetch_add(sanitized, std::memory_order_relaxed);
+        TRACE_COUNT(LinesProcessed, batch->lines.size());
+        TRACE_VALUE("SecurePipeline batch lines", batch->lines.size());
+        validate_.lines.fetch_add(batch->lines.size(), std::memory_order_relaxed);
+        validate_.bytes.fetch_add(written, std::memory_order_relaxed);
+        validate_.batches.fetch_add(1, std::memory_order_relaxed);
+        validate_.busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+        bool last = batch->last;
+        forward(toTransform_, toTransformCounters_, validate_, batch);
+        if (last) return;
+    }
+}
+
+void SecurePipeline::transformer() {
+    while (true) {
+        Batch* batch = toTransform_.pop();
+        TRACE_SCOPE("SecurePipeline::transform batch");
+        uint64_t start = nowNs();
+        batch->output.clear();
+        if (!failed_.load(std::memory_order_relaxed)) {
+            try {
+                const char* text = batch->text.get();
+                for (size_t i = 0; i < batch->lines.size(); ++i) {
+                    const LineSpan& span = batch->lines[i];
+                    transform_(batch->firstLine + i, std::string_view(text + span.offset, span.length), batch->output);
+                }
+            } catch (...) {
+                fail(std::current_exception());
+                batch->output.clear();
+            }
+        }
+
+        transformStage_.lines.fetch_add(batch->lines.size(), std::memory_order_relaxed);
+        transformStage_.bytes.fetch_add(batch->output.size(), std::memory_order_relaxed);
+        transformStage_.batches.fetch_add(1, std::memory_order_relaxed);
+        transformStage_.busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+        bool last = batch->last;
+        forward(toSink_, toSinkCounters_, transformStage_, batch);
+        if (last) return;
+    }
+}
+
+void SecurePipeline::sinker() {
+    bool accepting = true;
+    while (true) {
+        Batch* batch = toSink_.pop();
+        TRACE_SCOPE("SecurePipeline::sink batch");
+        uint64_t start = nowNs();
+        size_t lines = 0, bytes = 0;
+        if (accepting && !failed_.load(std::memory_order_relaxed) && !batch->output.empty()) {
+            try {
+                accepting = sink_(batch->output);
+                if (!accepting) stop_ = true;
+                lines = batch->lines.size();
+                bytes = batch->output.size();
+            } catch (...) {
+                fail(std::current_exception());
+            }
+        }
+
+        sinkStage_.lines.fetch_add(lines, std::memory_order_relaxed);
+        sinkStage_.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        sinkStage_.batches.fetch_add(1, std::memory_order_relaxed);
+        sinkStage_.busyNs.fetch_add(nowNs() - start, std::memory_order_relaxed);
+        bool last = batch->last;
+        free_.push(batch);  // Never blocks: free_ holds every batch
+        if (last) return;
+    }
+}
+
+void SecurePipeline::resetCounters() {
+    for (StageCounters* stage : {&read_, &validate_, &transformStage_, &sinkStage_}) {
+        stage->lines = 0;
+        stage->bytes = 0;
+        stage->batches = 0;
+        stage->busyNs = 0;
+        stage->blockedNs = 0;
+    }
+    for (QueueCounters* queue : {&toValidateCounters_, &toTransformCounters_, &toSinkCounters_}) {
+        queue->maxDepth = 0;
+        queue->fullWaits = 0;
+    }
+    sanitizedLines_ = 0;
+    flaggedLines_ = 0;
+    cutLines_ = 0;
+    elapsedNs_ = 0;
+}
+
+SecurePipeline::Stats SecurePipeline::stats() const {
+    auto stage = [](const StageCounters& c) {
+        StageStats s;
+        s.lines = c.lines.load(std::memory_order_relaxed);
+        s.bytes = c.bytes.load(std::memory_order_relaxed);
+        s.batches = c.batches.load(std::memory_order_relaxed);
+        s.busyNs = c.busyNs.load(std::memory_order_relaxed);
+        s.blockedNs = c.blockedNs.load(std::memory_order_relaxed);
+        return s;
+    };
+    auto queue = [](const Queue& q, const QueueCounters& c) {
+        QueueStats s;
+        s.capacity = q.capacity();
+        s.depth = q.size();
+        s.maxDepth = c.maxDepth.load(std::memory_order_relaxed);
+        s.fullWaits = c.fullWaits.load(std::memory_order_relaxed);
+        return s;
+    };
+
+    Stats stats;
+    stats.read = stage(read_);
+    stats.validate = stage(validate_);
+    stats.transform = stage(transformStage_);
+    stats.sink = stage(sinkStage_);
+    stats.toValidate = queue(toValidate_, toValidateCounters_);
+    stats.toTransform = queue(toTransform_, toTransformCounters_);
+    stats.toSink = queue(toSink_, toSinkCounters_);
+    stats.sanitizedLines = sanitizedLines_.load(std::memory_order_relaxed);
+    stats.flaggedLines = flaggedLines_.load(std::memory_order_relaxed);
+    stats.cutLines = cutLines_.load(std::memory_order_relaxed);
+    stats.seconds = static_cast<double>(elapsedNs_.load(std::memory_order_relaxed)) / 1e9;
+    return stats;
+}
+
+std::string SecurePipeline::describe(const Stats& stats) {
+    std::string out;
+    char line[160];
+    snprintf(line, sizeof(line), "  %-10s %12s %10s %12s %11s\n", "stage", "lines", "MB", "MB/s busy", "blocked ms");
+    out += line;
+    auto stage = [&](const char* name, const StageStats& s) {
+        double mb = static_cast<double>(s.bytes) / (1 << 20);
+        double busy = static_cast<double>(s.busyNs) / 1e9;
+        snprintf(line, sizeof(line), "  %-10s %12llu %10.1f %12.1f %11.1f\n", name,
+                 static_cast<unsigned long long>(s.lines), mb, busy > 0 ? mb / busy : 0.0,
+                 static_cast<double>(s.blockedNs) / 1e6);
+        out += line;
+    };
+    stage("read", stats.read);
+    stage("validate", stats.validate);
+    stage("transform", stats.transform);
+    stage("sink", stats.sink);
+
+    snprintf(line, sizeof(line), "  %-14s %8s %8s %8s %10s\n", "queue", "depth", "max", "capacity", "full waits");
+    out += line;
+    auto queue = [&](const char* name, const QueueStats& q) {
+        snprintf(line, sizeof(line), "  %-14s %8zu %8zu %8zu %10llu\n", name, q.depth, q.maxDepth, q.capacity,
+                 static_cast<unsigned long long>(q.fullWaits));
+        out += line;
+    };
+    queue("read>validate", stats.toValidate);
+    queue("validate>xform", stats.toTransform);
+    queue("xform>sink", stats.toSink);
+
+    snprintf(line, sizeof(line), "  %llu lines sanitized, %llu flagged, %llu cut, %.3f s\n",
+             static_cast<unsigned long long>(stats.sanitizedLines), static_cast<unsigned long long>(stats.flaggedLines),
+             static_cast<unsigned long long>(stats.cutLines), stats.seconds);
+    out += line;
+    return out;
+}
+
+} // namespace format_security
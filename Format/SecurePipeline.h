@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Concurrency/SpscQueue.h"
+#include "../Files/LineScanner.h"
+
+namespace format_security {
+
+class PatternScanner;
+
+// Streaming counterpart of FormatDemo::secureFileProcessing:
+//
+//   read -> validate/sanitize -> transform -> sink
+//
+// Each stage runs on its own thread and hands fixed-size batches of lines
+// to the next through a bounded SpscQueue. A fixed set of batches circulates
+// (the sink hands spent ones back to the reader), so memory stays constant
+// for any input size, and a slow sink stalls the stages behind it instead
+// of letting queues grow.
+class SecurePipeline {
+public:
+    struct Options {
+        size_t batchBytes = 64 * 1024;  // Input bytes per batch; longer lines are cut
+        size_t queueDepth = 8;          // Batches per inter-stage queue
+        size_t maxLines = 0;            // Stop after this many lines (0 = all)
+        // Counts lines with matches (before sanitizing), one pass per batch;
+        // must outlive the run
+        const PatternScanner* scanner = nullptr;
+    };
+
+    // Appends the output for one sanitized line to out
+    using Transform = std::function<void(size_t lineNumber, std::string_view line, std::string& out)>;
+    // Receives each batch's transformed output; returning false stops the run
+    using Sink = std::function<bool(std::string_view output)>;
+
+    struct StageStats {
+        uint64_t lines = 0;
+        uint64_t bytes = 0;      // Bytes the stage produced
+        uint64_t batches = 0;
+        uint64_t busyNs = 0;     // Time spent processing
+        uint64_t blockedNs = 0;  // Time waiting for room downstream (backpressure)
+    };
+
+    struct QueueStats {
+        size_t capacity = 0;
+        size_t depth = 0;        // Batches queued at the time of the snapshot
+        size_t maxDepth = 0;
+        uint64_t fullWaits = 0;  // Pushes that found the queue full
+    };
+
+    struct Stats {
+        StageStats read, validate, transform, sink;
+        QueueStats toValidate, toTransform, toSink;
+        uint64_t sanitizedLines = 0;  // Lines with '%' or '\r' rewritten to '_' (never truncated)
+        uint64_t flaggedLines = 0;    // Lines the scanner matched
+        uint64_t cutLines = 0;        // Lines longer than a batch, cut by the reader
+        double seconds = 0;
+    };
+
+    SecurePipeline();
+    explicit SecurePipeline(Options options);
+    ~SecurePipeline();
+
+    SecurePipeline(const SecurePipeline&) = delete;
+    SecurePipeline& operator=(const SecurePipeline&) = delete;
+
+    // Defaults: "Line N: text\n" (secureFileProcessing's output) into stdout
+    void setTransform(Transform transform);
+    void setSink(Sink sink);
+
+    // Runs to the end of the input (or maxLines, or a sink stop). Callback
+    // exceptions stop the run and are rethrown here.
+    void run(std::istream& input);
+    // False if the file cannot be opened
+    bool run(const std::string& filename);
+
+    // Live counters; safe to call from another thread during run
+    Stats stats() const;
+
+    static std::string describe(const Stats& stats);
+
+private:
+    struct Batch;
+    struct StageCounters {
+        std::atomic<uint64_t> lines{0}, bytes{0}, batches{0}, busyNs{0}, blockedNs{0};
+    };
+    struct QueueCounters {
+        std::atomic<size_t> maxDepth{0};
+        std::atomic<uint64_t> fullWaits{0};
+    };
+    using Queue = SpscQueue<Batch*>;
+
+    void reader(std::istream& input);
+    void validator();
+    void transformer();
+    void sinker();
+
+    // Push with backpressure accounting
+    void forward(Queue& queue, QueueCounters& counters, StageCounters& stage, Batch* batch);
+    void fail(std::exception_ptr error);
+    void resetCounters();
+
+    Options options_;
+    Transform transform_;
+    Sink sink_;
+
+    std::vector<std::unique_ptr<Batch>> batches_;
+    Queue free_, toValidate_, toTransform_, toSink_;
+    StageCounters read_, validate_, transformStage_, sinkStage_;
+    QueueCounters toValidateCounters_, toTransformCounters_, toSinkCounters_;
+    std::atomic<uint64_t> sanitizedLines_{0}, flaggedLines_{0}, cutLines_{0};
+    std::atomic<uint64_t> elapsedNs_{0};
+
+    std::atomic<bool> stop_{false};
+    std::exception_ptr error_;
+    std::atomic<bool> failed_{false};
+};
+
+} // namespace format_security
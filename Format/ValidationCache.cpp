@@ -0,0 +1,208 @@
+#include "ValidationCache.h"
+#include "FilenameValidator.h"
+#include "FormatSecurity.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace format_security {
+
+// One entry, stored inline in its shard's table. When sanitizing leaves the
+// input unchanged (the common case) `sanitized` shares the key's block, so
+// a hit reads one slot and one string block.
+struct ValidationCache::Slot {
+    uint64_t hash = 0;
+    ptrdemo::SharedString key;
+    ptrdemo::SharedString sanitized;
+    uint32_t bytes = 0;
+    bool used = false;
+    bool valid = false;
+    // CLOCK reference bit: set by hits under the shared lock
+    mutable std::atomic<bool> referenced{false};
+
+    Slot() = default;
+    Slot(Slot&& other) noexcept { *this = std::move(other); }
+    Slot& operator=(Slot&& other) noexcept {
+        hash = other.hash;
+        key = std::move(other.key);
+        sanitized = std::move(other.sanitized);
+        bytes = other.bytes;
+        used = std::exchange(other.used, false);
+        valid = other.valid;
+        referenced.store(other.referenced.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+};
+
+// Linear-probing table; shards sit on their own cache lines so counters and
+// locks of neighbours don't false-share
+struct alignas(64) ValidationCache::Shard {
+    mutable std::shared_mutex mutex;
+    std::vector<Slot> table;  // Power-of-two size, at most 3/4 full
+    size_t count = 0;
+    size_t hand = 0;
+    size_t bytes = 0;
+    size_t budget = 0;
+    std::atomic<uint64_t> hits{0}, misses{0}, evictions{0};
+
+    size_t mask() const { return table.size() - 1; }
+
+    // Slot holding `key`, or the empty slot ending its probe sequence
+    size_t find(std::string_view key, uint64_t hash) const {
+        size_t i = hash & mask();
+        while (table[i].used && !(table[i].hash == hash && table[i].key.view() == key)) i = (i + 1) & mask();
+        return i;
+    }
+
+    void grow() {
+        std::vector<Slot> old = std::exchange(table, std::vector<Slot>(std::max<size_t>(table.size() * 2, 16)));
+        for (Slot& slot : old) {
+            if (slot.used) table[find(slot.key.view(), slot.hash)] = std::move(slot);
+        }
+        hand = 0;
+    }
+
+    // Backward-shift deletion: pulls later members of the probe run into
+    // the hole, so lookups never need tombstones
+    void erase(size_t hole) {
+        bytes -= table[hole].bytes;
+        --count;
+        for (size_t j = (hole + 1) & mask(); table[j].used; j = (j + 1) & mask()) {
+            size_t home = table[j].hash & mask();
+            // Must stay when its home lies cyclically in (hole, j]
+            bool stays = hole <= j ? hole < home && home <= j : hole < home || home <= j;
+            if (!stays) {
+                table[hole] = std::move(table[j]);
+                hole = j;
+            }
+        }
+        table[hole] = Slot{};
+    }
+
+    // CLOCK: sweep from the hand, giving referenced entries a second
+    // chance, until `needed` more bytes fit
+    void makeRoom(size_t needed) {
+        while (bytes + needed > budget && count > 0) {
+            hand &= mask();
+            Slot& slot = table[hand];
+            if (slot.used && !slot.referenced.exchange(false, std::memory_order_relaxed)) {
+                erase(hand);  // May shift another entry into the hand's slot
+                evictions.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                ++hand;
+            }
+        }
+    }
+};
+
+ValidationCache::ValidationCache() : ValidationCache(Options{}) {}
+
+ValidationCache::ValidationCache(Options options) : options_(options) {
+    options_.shards = std::bit_ceil(std::clamp<size_t>(options_.shards, 1, 1024));
+    shardShift_ = 64 - static_cast<unsigned>(std::countr_zero(options_.shards));
+    shards_ = std::make_unique<Shard[]>(options_.shards);
+    for (size_t i = 0; i < options_.shards; ++i) {
+        shards_[i].budget = options_.maxBytes / options_.shards;
+        shards_[i].grow();
+    }
+}
+
+ValidationCache::~ValidationCache() = default;
+
+size_t ValidationCache::entryBytes(std::string_view input, const ptrdemo::SharedString& sanitized) {
+    // Two table slots (the table runs up to 3/4 full and grows by doubling)
+    // plus the string blocks that don't fit inline
+    auto block = [](size_t size) { return size > ptrdemo::SharedString::inlineCapacity ? 16 + size + 1 : 0; };
+    size_t bytes = 2 * sizeof(Slot) + block(input.size());
+    if (sanitized.view() != input) bytes += block(sanitized.size());
+    return bytes;
+}
+
+ValidationCache::Shard& ValidationCache::shardFor(uint64_t hash) const {
+    // High bits pick the shard; the table index uses the low ones
+    return shards_[shardShift_ == 64 ? 0 : hash >> shardShift_];
+}
+
+ValidationCache::Result ValidationCache::lookup(std::string_view input) {
+    const uint64_t hash = std::hash<std::string_view>{}(input);
+    Shard& shard = shardFor(hash);
+
+    {
+        std::shared_lock lock(shard.mutex);
+        const Slot& slot = shard.table[shard.find(input, hash)];
+        if (slot.used) {
+            if (!slot.referenced.load(std::memory_order_relaxed)) {
+                slot.referenced.store(true, std::memory_order_relaxed);
+            }
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            return Result{slot.valid, slot.sanitized};
+        }
+    }
+
+    // Miss: compute without holding the lock. A one-name batch and a stack
+    // buffer give the same answers as the FormatDemo helpers without their
+    // std::string allocations.
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    Result result;
+    const uint32_t offsets[2] = {0, static_cast<uint32_t>(std::min<size_t>(input.size(), UINT32_MAX))};
+    FilenameVerdict verdict;
+    result.valid = input.size() <= FilenameValidator::maxLength &&
+                   FilenameValidator::validate(input.data(), offsets, 1, &verdict) == 1;
+    char buffer[FormatDemo::maxSanitizedLength];
+    std::string_view sanitized(buffer, FormatDemo::sanitizeInto(input, buffer));
+    ptrdemo::SharedString key(input);
+    result.sanitized = sanitized == input ? key : ptrdemo::SharedString(sanitized);
+
+    const size_t bytes = entryBytes(input, result.sanitized);
+    if (bytes > shard.budget) return result;  // Would evict everything for one entry
+
+    std::unique_lock lock(shard.mutex);
+    if (shard.table[shard.find(input, hash)].used) return result;  // Another thread got here first
+
+    shard.makeRoom(bytes);
+    if ((shard.count + 1) * 4 > shard.table.size() * 3) shard.grow();
+    Slot& slot = shard.table[shard.find(input, hash)];
+    slot.hash = hash;
+    slot.key = std::move(key);
+    slot.sanitized = result.sanitized;
+    slot.bytes = static_cast<uint32_t>(bytes);
+    slot.valid = result.valid;
+    slot.used = true;
+    ++shard.count;
+    shard.bytes += bytes;
+    return result;
+}
+
+ValidationCache::Stats ValidationCache::stats() const {
+    Stats stats;
+    for (size_t i = 0; i < options_.shards; ++i) {
+        const Shard& shard = shards_[i];
+        stats.hits += shard.hits.load(std::memory_order_relaxed);
+        stats.misses += shard.misses.load(std::memory_order_relaxed);
+        stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+        std::shared_lock lock(shard.mutex);
+        stats.entries += shard.count;
+        stats.bytes += shard.bytes;
+    }
+    return stats;
+}
+
+void ValidationCache::clear() {
+    for (size_t i = 0; i < options_.shards; ++i) {
+        Shard& shard = shards_[i];
+        std::unique_lock lock(shard.mutex);
+        shard.table.clear();
+        shard.count = 0;
+        shard.bytes = 0;
+        shard.grow();
+    }
+}
+
+} // namespace format_security
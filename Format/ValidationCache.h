@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "../Pointers/shared_string.h"
+
+namespace format_security {
+
+// Memoizes FormatDemo::isValidFilename and sanitizeInput for inputs that
+// repeat (the same paths and user strings, over and over). Each distinct
+// input is validated and sanitized once; the sanitized text is interned
+// as a SharedString, so a hit copies a 16-byte handle instead of
+// allocating a new string.
+//
+// Entries are spread over shards by hash. A hit takes its shard's lock
+// shared and only sets a reference bit; a miss computes the result outside
+// any lock, then inserts under the exclusive lock. Each shard is an
+// open-addressing table holding the entries inline, and holds at most
+// maxBytes / shards bytes (keys, results and bookkeeping) and evicts with
+// CLOCK: the hand clears reference bits until it finds an entry not used
+// since its last sweep.
+class ValidationCache {
+public:
+    struct Options {
+        size_t maxBytes = 4 * 1024 * 1024;
+        size_t shards = 16;  // Rounded up to a power of two
+    };
+
+    struct Result {
+        bool valid = false;               // isValidFilename(input)
+        ptrdemo::SharedString sanitized;  // sanitizeInput(input)
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+    };
+
+    ValidationCache();
+    explicit ValidationCache(Options options);
+    ~ValidationCache();
+
+    ValidationCache(const ValidationCache&) = delete;
+    ValidationCache& operator=(const ValidationCache&) = delete;
+
+    // Safe to call from any number of threads
+    Result lookup(std::string_view input);
+    bool isValidFilename(std::string_view input) { return lookup(input).valid; }
+    ptrdemo::SharedString sanitize(std::string_view input) { return lookup(input).sanitized; }
+
+    Stats stats() const;
+    void clear();
+
+    // Approximate footprint of one entry (what counts against maxBytes)
+    static size_t entryBytes(std::string_view input, const ptrdemo::SharedString& sanitized);
+
+private:
+    struct Slot;
+    struct Shard;
+
+    Shard& shardFor(uint64_t hash) const;
+
+    Options options_;
+    unsigned shardShift_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace format_security
@@ -0,0 +1,392 @@
+#include "AsyncLogger.h"
+
+#include <bit>
+#include <cstring>
+#include <ctime>
+
+using format_security::FormatArg;
+using format_security::FormatArgKind;
+
+namespace logging {
+
+namespace {
+
+// Fixed part of every record; FormatArgs and copied string bytes follow.
+// `size` comes first so a wrap marker only needs those 4 bytes.
+struct RecordHeader {
+    uint32_t size;        // Whole record, multiple of 8; kWrapMarker = skip to ring start
+    uint8_t level;
+    uint8_t argCount;
+    uint16_t formatSize;
+    const char* format;
+    int64_t timestampNs;  // system_clock, since epoch
+};
+
+constexpr uint32_t kWrapMarker = 0x80000000u;
+constexpr size_t kMaxArgs = 255;
+constexpr size_t kBatchBytes = 64 * 1024;
+
+constexpr size_t alignUp(size_t n) { return (n + 7) & ~size_t{7}; }
+
+std::atomic<uint64_t> nextLoggerId{1};
+
+// Set by the owning thread when it exits; the flusher then drains the
+// ring one last time and frees it
+struct RingRetirement {
+    std::atomic<bool> retired{false};
+};
+
+// Per-thread cache of this thread's ring in each logger. The raw pointer
+// serves log(); the weak reference lets thread exit retire rings without
+// touching loggers that are already gone.
+struct RingCache {
+    struct Entry {
+        uint64_t loggerId;
+        void* ring;
+        std::weak_ptr<RingRetirement> retirement;
+    };
+    std::vector<Entry> entries;
+
+    ~RingCache() {
+        for (Entry& entry : entries) {
+            if (auto ring = entry.retirement.lock()) ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+thread_local RingCache ringCache;
+
+const char* levelName(Level level) {
+    switch (level) {
+        case Level::Debug: return "DEBUG";
+        case Level::Info: return "INFO ";
+        case Level::Warn: return "WARN ";
+        case Level::Error: return "ERROR";
+    }
+    return "?    ";
+}
+
+void appendJsonEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+}
+
+} // namespace
+
+// Single-producer (owning thread) / single-consumer (flusher) byte ring
+struct AsyncLogger::Ring : RingRetirement {
+    Ring(size_t capacity, uint32_t thread)
+        : storage(new uint64_t[capacity / 8]), capacity(capacity), threadId(thread) {}
+
+    std::byte* at(uint64_t position) {
+        return reinterpret_cast<std::byte*>(storage.get()) + (position & (capacity - 1));
+    }
+
+    std::unique_ptr<uint64_t[]> storage;  // uint64_t keeps records 8-aligned
+    const size_t capacity;
+    const uint32_t threadId;
+
+    alignas(64) std::atomic<uint64_t> head{0};  // Written by the producer
+    uint64_t cachedTail = 0;                    // Producer's last view of tail
+    std::atomic<uint64_t> records{0};
+    std::atomic<uint64_t> dropped{0};
+    LatencyHistogram latency;
+
+    alignas(64) std::atomic<uint64_t> tail{0};  // Written by the flusher
+};
+
+AsyncLogger::AsyncLogger(LoggerOptions options)
+    : options_(options), id_(nextLoggerId.fetch_add(1)) {
+    size_t minimum = 4096;
+    options_.ringBytes = std::bit_ceil(options_.ringBytes < minimum ? minimum : options_.ringBytes);
+    flusher_ = std::thread([this] { flusherLoop(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    flusher_.join();
+}
+
+AsyncLogger& AsyncLogger::console() {
+    static AsyncLogger logger([] {
+        LoggerOptions options;
+        options.layout = Layout::Plain;
+        return options;
+    }());
+    return logger;
+}
+
+AsyncLogger::Ring& AsyncLogger::localRing() {
+    for (const auto& entry : ringCache.entries) {
+        if (entry.loggerId == id_) return *static_cast<Ring*>(entry.ring);
+    }
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    auto ring = std::make_shared<Ring>(options_.ringBytes, nextThreadId_++);
+    rings_.push_back(ring);
+    ringCache.entries.push_back({id_, ring.get(), ring});
+    return *ring;
+}
+
+void AsyncLogger::enqueue(Level level, std::string_view format, const FormatArg* args, size_t count) {
+    auto start = options_.measureLatency ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+    Ring& ring = localRing();
+
+    // Strings are copied so the caller's buffers may change right after
+    // log() returns; oversized payloads are cut to keep records well below
+    // the ring size.
+    size_t stringBudget = ring.capacity / 4;
+    size_t stringBytes = 0;
+    count = count < kMaxArgs ? count : kMaxArgs;
+    for (size_t i = 0; i < count; ++i) {
+        if (args[i].kind == FormatArgKind::String) stringBytes += args[i].s.size;
+    }
+    stringBytes = stringBytes < stringBudget ? stringBytes : stringBudget;
+    size_t size = alignUp(sizeof(RecordHeader) + count * sizeof(FormatArg) + stringBytes);
+    if (size > ring.capacity / 2) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Reserve contiguous space, wrapping with a marker when the tail end is too short
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    size_t contiguous = ring.capacity - (head & (ring.capacity - 1));
+    size_t needed = size > contiguous ? contiguous + size : size;
+    while (ring.capacity - (head - ring.cachedTail) < needed) {
+        ring.cachedTail = ring.tail.load(std::memory_order_acquire);
+        if (ring.capacity - (head - ring.cachedTail) >= needed) break;
+        if (options_.dropWhenFull) {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wake_.notify_one();
+        std::this_thread::yield();
+    }
+    if (size > contiguous) {
+        uint32_t marker = kWrapMarker;
+        std::memcpy(ring.at(head), &marker, sizeof(marker));
+        head += contiguous;
+    }
+
+    std::byte* out = ring.at(head);
+    RecordHeader header{};
+    header.size = static_cast<uint32_t>(size);
+    header.level = static_cast<uint8_t>(level);
+    header.argCount = static_cast<uint8_t>(count);
+    header.formatSize = static_cast<uint16_t>(format.size() < 0xFFFF ? format.size() : 0xFFFF);
+    header.format = format.data();
+    header.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), args, count * sizeof(FormatArg));
+
+    std::byte* strings = out + sizeof(header) + count * sizeof(FormatArg);
+    size_t remaining = stringBytes;
+    for (size_t i = 0; i < count; ++i) {
+        if (args[i].kind != FormatArgKind::String) continue;
+        size_t n = args[i].s.size < remaining ? args[i].s.size : remaining;
+        std::memcpy(strings, args[i].s.data, n);
+        // The flusher re-points the string at the copy; record the kept length
+        auto* stored = reinterpret_cast<FormatArg*>(out + sizeof(header)) + i;
+        std::memcpy(&stored->s.size, &n, sizeof(n));
+        strings += n;
+        remaining -= n;
+    }
+
+    ring.head.store(head + size, std::memory_order_release);
+    ring.records.fetch_add(1, std::memory_order_relaxed);
+
+    if (options_.measureLatency) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        ring.latency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+}
+
+bool AsyncLogger::drain(Ring& ring, std::string& batch) {
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    const uint64_t head = ring.head.load(std::memory_order_acquire);
+    if (tail == head) return false;
+
+    FormatArg args[kMaxArgs + 1];
+    char message[4096];
+    std::string large;
+    char timeText[32] = "";
+    int64_t cachedSecond = -1;
+
+    while (tail != head) {
+        uint32_t size;
+        std::memcpy(&size, ring.at(tail), sizeof(size));
+        if (size == kWrapMarker) {
+            tail += ring.capacity - (tail & (ring.capacity - 1));
+            continue;
+        }
+
+        const std::byte* in = ring.at(tail);
+        RecordHeader header;
+        std::memcpy(&header, in, sizeof(header));
+        std::memcpy(args, in + sizeof(header), header.argCount * sizeof(FormatArg));
+        const char* strings = reinterpret_cast<const char*>(in + sizeof(header) + header.argCount * sizeof(FormatArg));
+        for (size_t i = 0; i < header.argCount; ++i) {
+            if (args[i].kind != FormatArgKind::String) continue;
+            args[i].s.data = strings;
+            strings += args[i].s.size;
+        }
+
+        std::string_view format(header.format, header.formatSize);
+        size_t length = format_security::detail::vformatTo(message, format, args, header.argCount);
+        std::string_view text(message, length);
+        if (length > sizeof(message)) {
+            large.resize(length);
+            format_security::detail::vformatTo(large, format, args, header.argCount);
+            text = large;
+        }
+
+        auto level = static_cast<Level>(header.level);
+        switch (options_.layout) {
+            case Layout::Plain:
+                batch += text;
+                break;
+            case Layout::Text: {
+                int64_t second = header.timestampNs / 1000000000;
+                if (second != cachedSecond) {
+                    std::time_t t = static_cast<std::time_t>(second);
+                    std::tm utc{};
+                    gmtime_r(&t, &utc);
+                    strftime(timeText, sizeof(timeText), "%Y-%m-%dT%H:%M:%S", &utc);
+                    cachedSecond = second;
+                }
+                char prefix[96];
+                int n = snprintf(prefix, sizeof(prefix), "%s.%06lldZ %s [%u] ", timeText,
+                                 static_cast<long long>(header.timestampNs % 1000000000 / 1000),
+                                 levelName(level), ring.threadId);
+                batch.append(prefix, static_cast<size_t>(n));
+                batch += text;
+                break;
+            }
+            case Layout::JsonLines: {
+                char prefix[96];
+                std::string_view name = levelName(level);
+                while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+                int n = snprintf(prefix, sizeof(prefix), "{\"ts\":%lld,\"level\":\"%.*s\",\"thread\":%u,\"msg\":\"",
+                                 static_cast<long long>(header.timestampNs), static_cast<int>(name.size()),
+                                 name.data(), ring.threadId);
+                batch.append(prefix, static_cast<size_t>(n));
+                appendJsonEscaped(batch, text);
+                batch += "\"}";
+                break;
+            }
+        }
+        batch += '\n';
+
+        tail += header.size;
+        if (batch.size() >= kBatchBytes) {
+            // Release ring space early so blocked producers can continue
+            ring.tail.store(tail, std::memory_order_release);
+            writeBatch(batch);
+        }
+    }
+    ring.tail.store(tail, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogger::writeBatch(std::string& batch) {
+    if (batch.empty()) return;
+    fwrite(batch.data(), 1, batch.size(), options_.sink);
+    bytesWritten_.fetch_add(batch.size(), std::memory_order_relaxed);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    batch.clear();
+}
+
+void AsyncLogger::flusherLoop() {
+    std::string batch;
+    batch.reserve(kBatchBytes * 2);
+    std::vector<Ring*> snapshot, retired;
+
+    for (;;) {
+        uint64_t epoch;
+        bool stopping;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            epoch = flushRequested_;
+            stopping = stop_;
+        }
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex_);
+            snapshot.clear();
+            for (auto& ring : rings_) snapshot.push_back(ring.get());
+        }
+
+        bool drained = false;
+        retired.clear();
+        for (Ring* ring : snapshot) {
+            // Read before draining: a retired ring gets no more records
+            if (ring->retired.load(std::memory_order_acquire)) retired.push_back(ring);
+            drained |= drain(*ring, batch);
+        }
+        writeBatch(batch);
+        if (!retired.empty()) releaseRings(retired);
+        if (drained || epoch > flushCompleted_) fflush(options_.sink);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        flushCompleted_ = epoch;
+        flushed_.notify_all();
+        if (drained) continue;
+        if (stopping) return;
+        wake_.wait_for(lock, options_.flushInterval, [this] {
+            return stop_ || flushRequested_ > flushCompleted_;
+        });
+    }
+}
+
+void AsyncLogger::releaseRings(const std::vector<Ring*>& retired) {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    for (Ring* ring : retired) {
+        retiredRecords_ += ring->records.load(std::memory_order_relaxed);
+        retiredDropped_ += ring->dropped.load(std::memory_order_relaxed);
+        retiredLatency_.merge(ring->latency);
+        std::erase_if(rings_, [&](const std::shared_ptr<Ring>& owned) { return owned.get() == ring; });
+    }
+}
+
+void AsyncLogger::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t target = ++flushRequested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [&] { return flushCompleted_ >= target; });
+}
+
+AsyncLogger::Stats AsyncLogger::stats() const {
+    Stats stats;
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    stats.records = retiredRecords_;
+    stats.dropped = retiredDropped_;
+    stats.producerLatency.merge(retiredLatency_);
+    stats.rings = rings_.size();
+    for (const auto& ring : rings_) {
+        stats.records += ring->records.load(std::memory_order_relaxed);
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+        stats.producerLatency.merge(ring->latency);
+    }
+    stats.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace logging
@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "LatencyHistogram.h"
+#include "../Format/SafeFormat.h"
+
+namespace logging {
+
+enum class Level : uint8_t { Debug, Info, Warn, Error };
+
+enum class Layout : uint8_t {
+    Plain,      // Message only (drop-in for cout << ... << '\n')
+    Text,       // "2026-01-01T00:00:00.000000Z INFO  [3] message"
+    JsonLines,  // {"ts":...,"level":"INFO","thread":3,"msg":"..."}
+};
+
+struct LoggerOptions {
+    FILE* sink = stdout;
+    Layout layout = Layout::Text;
+    Level minLevel = Level::Info;
+    size_t ringBytes = 1 << 20;   // Per producer thread; rounded up to a power of two
+    bool dropWhenFull = false;    // Otherwise producers wait for the flusher
+    bool measureLatency = false;  // Record producer-side log() latency
+    std::chrono::milliseconds flushInterval{5};
+};
+
+// Asynchronous logger with deferred formatting. log() checks the format at
+// compile time (FormatString, as with formatTo), copies the raw arguments
+// (string contents included) into the calling thread's own lock-free SPSC
+// ring and returns. A background thread drains all rings, formats, and
+// writes in large batches, so producers never touch the stream or its lock.
+// Format strings must be literals (static storage): only the pointer is kept.
+// Ordering is per thread; records from different threads may interleave.
+// A thread's ring is freed once the thread has exited and the flusher has
+// written what it left, so short-lived threads do not accumulate rings.
+class AsyncLogger {
+public:
+    struct Stats {
+        uint64_t records = 0;
+        uint64_t dropped = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t batches = 0;
+        size_t rings = 0;                  // Allocated now (threads that logged and have not exited)
+        LatencyHistogram producerLatency;  // Empty unless measureLatency
+    };
+
+    explicit AsyncLogger(LoggerOptions options = {});
+    ~AsyncLogger();  // Drains everything, then stops the flusher
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    template <typename... Args>
+    void log(Level level, format_security::FormatString<Args...> format, const Args&... args) {
+        if (level < options_.minLevel) return;
+        const format_security::FormatArg packed[] = {
+            format_security::detail::makeArg(args)..., format_security::FormatArg{format_security::FormatArgKind::Bool, {}}};
+        enqueue(level, format.get(), packed, sizeof...(Args));
+    }
+
+    template <typename... Args>
+    void debug(format_security::FormatString<Args...> format, const Args&... args) { log(Level::Debug, format, args...); }
+    template <typename... Args>
+    void info(format_security::FormatString<Args...> format, const Args&... args) { log(Level::Info, format, args...); }
+    template <typename... Args>
+    void warn(format_security::FormatString<Args...> format, const Args&... args) { log(Level::Warn, format, args...); }
+    template <typename... Args>
+    void error(format_security::FormatString<Args...> format, const Args&... args) { log(Level::Error, format, args...); }
+
+    // Blocks until everything logged before the call has been written and
+    // the sink flushed; use before mixing with direct cout/printf output.
+    void flush();
+
+    Stats stats() const;
+
+    // Shared Plain-layout logger on stdout for the demos' line output
+    static AsyncLogger& console();
+
+private:
+    struct Ring;
+
+    Ring& localRing();
+    void enqueue(Level level, std::string_view format, const format_security::FormatArg* args, size_t count);
+    bool drain(Ring& ring, std::string& batch);
+    void writeBatch(std::string& batch);
+    void flusherLoop();
+    // Frees drained rings of exited threads, keeping their counts for stats()
+    void releaseRings(const std::vector<Ring*>& retired);
+
+    LoggerOptions options_;
+    const uint64_t id_;  // Distinguishes loggers in the thread-local ring cache
+
+    mutable std::mutex ringsMutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;  // The owning thread's cache holds a weak reference
+    uint32_t nextThreadId_ = 1;
+    uint64_t retiredRecords_ = 0;
+    uint64_t retiredDropped_ = 0;
+    LatencyHistogram retiredLatency_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    uint64_t flushRequested_ = 0;
+    uint64_t flushCompleted_ = 0;
+    bool stop_ = false;
+
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::thread flusher_;
+};
+
+} // namespace logging
@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace logging {
+
+// Log-linear histogram of nanosecond latencies: 8 linear sub-buckets per
+// power of two (<= 12.5% error), fixed size, no allocation. record() may run
+// concurrently with snapshot reads; counters are updated with relaxed
+// atomic_ref increments, which are uncontended when each thread owns one.
+class LatencyHistogram {
+public:
+    static constexpr size_t kSubBits = 3;
+    static constexpr size_t kBuckets = (64 - kSubBits + 1) << kSubBits;
+
+    void record(uint64_t nanos) {
+        std::atomic_ref<uint64_t>(counts_[bucketFor(nanos)]).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Adds a (possibly concurrently updated) histogram into this one
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < kBuckets; ++i) {
+            counts_[i] += std::atomic_ref<uint64_t>(const_cast<uint64_t&>(other.counts_[i])).load(std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (uint64_t c : counts_) total += c;
+        return total;
+    }
+
+    // Upper bound of the bucket holding the given quantile (0..1)
+    uint64_t percentile(double q) const {
+        uint64_t total = count();
+        if (total == 0) return 0;
+        auto rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return bucketUpperBound(i);
+        }
+        return bucketUpperBound(kBuckets - 1);
+    }
+
+private:
+    static size_t bucketFor(uint64_t v) {
+        if (v < (uint64_t{1} << kSubBits)) return static_cast<size_t>(v);
+        size_t exponent = static_cast<size_t>(std::bit_width(v)) - 1 - kSubBits;
+        size_t sub = static_cast<size_t>(v >> exponent) & ((size_t{1} << kSubBits) - 1);
+        return ((exponent + 1) << kSubBits) + sub;
+    }
+
+    static uint64_t bucketUpperBound(size_t bucket) {
+        if (bucket < (size_t{1} << kSubBits)) return bucket;
+        size_t exponent = (bucket >> kSubBits) - 1;
+        uint64_t sub = bucket & ((size_t{1} << kSubBits) - 1);
+        return (((uint64_t{1} << kSubBits) + sub + 1) << exponent) - 1;
+    }
+
+    std::array<uint64_t, kBuckets> counts_{};
+};
+
+} // namespace logging
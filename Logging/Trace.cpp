@@ -0,0 +1,283 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace logging::trace {
+
+namespace {
+
+// Counters on separate cache lines: threads bumping different counters
+// don't contend
+struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+};
+PaddedCounter gCounters[kCounters];
+
+std::atomic<bool> gRecording{false};
+std::atomic<uint32_t> gNextThread{1};
+
+uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Event {
+    const Site* site;
+    uint64_t start;
+    uint64_t duration;
+    uint32_t thread;
+};
+
+struct CounterSample {
+    uint64_t time;
+    std::array<uint64_t, kCounters> values;
+};
+
+struct ThreadEvents;
+
+// Process-wide state; deliberately never destroyed, so thread_local buffers
+// of threads that exit during static destruction can still retire into it
+struct Registry {
+    std::mutex mutex;
+    std::vector<const Site*> sites;
+    std::vector<ThreadEvents*> threads;
+    std::vector<Event> retired;  // Events of threads that have exited
+    std::vector<CounterSample> samples;
+    uint64_t origin = nowNanos();
+
+    static Registry& get() {
+        static Registry* registry = new Registry;
+        return *registry;
+    }
+
+    void addSite(const Site& site) {
+        std::lock_guard lock(mutex);
+        sites.push_back(&site);
+    }
+};
+
+// A thread's event buffer. Only its thread appends; the lock is for
+// writeChromeTrace and start() reading or clearing it concurrently.
+struct ThreadEvents {
+    std::mutex mutex;
+    std::vector<Event> events;
+    uint32_t id = gNextThread.fetch_add(1, std::memory_order_relaxed);
+    bool registered = false;
+
+    ~ThreadEvents() {
+        if (!registered) return;
+        Registry& registry = Registry::get();
+        std::lock_guard lock(registry.mutex);
+        registry.retired.insert(registry.retired.end(), events.begin(), events.end());
+        registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+    }
+
+    void append(const Event& event) {
+        if (!registered) {
+            Registry& registry = Registry::get();
+            std::lock_guard lock(registry.mutex);
+            registry.threads.push_back(this);
+            registered = true;
+        }
+        std::lock_guard lock(mutex);
+        events.push_back(event);
+    }
+};
+
+thread_local ThreadEvents tEvents;
+thread_local unsigned tDepth = 0;
+
+void appendEscaped(std::string& out, const char* text) {
+    for (const char* p = text; *p; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+}
+
+// Chrome trace timestamps are microseconds; keep nanosecond precision
+void appendMicros(std::string& out, uint64_t nanos) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%" PRIu64 ".%03u", nanos / 1000, static_cast<unsigned>(nanos % 1000));
+    out += buffer;
+}
+
+} // namespace
+
+const char* name(Counter counter) {
+    switch (counter) {
+        case Counter::BytesRead: return "bytes read";
+        case Counter::LinesProcessed: return "lines processed";
+        case Counter::RejectedFilenames: return "rejected filenames";
+        case Counter::Allocations: return "allocations";
+    }
+    return "?";
+}
+
+void add(Counter counter, uint64_t amount) {
+    gCounters[static_cast<size_t>(counter)].value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t value(Counter counter) {
+    return gCounters[static_cast<size_t>(counter)].value.load(std::memory_order_relaxed);
+}
+
+std::array<uint64_t, kCounters> counters() {
+    std::array<uint64_t, kCounters> values;
+    for (size_t i = 0; i < kCounters; ++i) values[i] = value(static_cast<Counter>(i));
+    return values;
+}
+
+Site::Site(const char* name, Kind kind) : name_(name), kind_(kind) {
+    Registry::get().addSite(*this);
+}
+
+Scope::Scope(Site& site) : site_(site), start_(nowNanos()) {
+    ++tDepth;
+}
+
+Scope::~Scope() {
+    uint64_t end = nowNanos();
+    site_.record(end - start_);
+    if (gRecording.load(std::memory_order_relaxed)) {
+        tEvents.append(Event{&site_, start_, end - start_, tEvents.id});
+        if (tDepth == 1) {
+            Registry& registry = Registry::get();
+            std::lock_guard lock(registry.mutex);
+            registry.samples.push_back(CounterSample{end, counters()});
+        }
+    }
+    --tDepth;
+}
+
+void start() {
+    Registry& registry = Registry::get();
+    std::lock_guard lock(registry.mutex);
+    registry.retired.clear();
+    registry.samples.clear();
+    for (ThreadEvents* thread : registry.threads) {
+        std::lock_guard threadLock(thread->mutex);
+        thread->events.clear();
+    }
+    registry.origin = nowNanos();
+    registry.samples.push_back(CounterSample{registry.origin, counters()});
+    gRecording.store(true, std::memory_order_relaxed);
+}
+
+void stop() {
+    gRecording.store(false, std::memory_order_relaxed);
+}
+
+bool recording() {
+    return gRecording.load(std::memory_order_relaxed);
+}
+
+void writeChromeTrace(std::ostream& out) {
+    Registry& registry = Registry::get();
+    std::vector<Event> events;
+    std::vector<CounterSample> samples;
+    uint64_t origin;
+    {
+        std::lock_guard lock(registry.mutex);
+        events = registry.retired;
+        for (ThreadEvents* thread : registry.threads) {
+            std::lock_guard threadLock(thread->mutex);
+            events.insert(events.end(), thread->events.begin(), thread->events.end());
+        }
+        samples = registry.samples;
+        origin = registry.origin;
+    }
+    samples.push_back(CounterSample{nowNanos(), counters()});
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.start < b.start; });
+
+    std::vector<uint32_t> threads;
+    for (const Event& event : events) threads.push_back(event.thread);
+    std::sort(threads.begin(), threads.end());
+    threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+
+    // Built in one string, written once
+    std::string json = "{\"traceEvents\":[\n";
+    json += R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"cpp_safety_demos"}})";
+    for (uint32_t thread : threads) {
+        json += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(thread) +
+                ",\"args\":{\"name\":\"thread " + std::to_string(thread) + "\"}}";
+    }
+    for (const Event& event : events) {
+        json += ",\n{\"name\":\"";
+        appendEscaped(json, event.site->name());
+        json += "\",\"cat\":\"scope\",\"ph\":\"X\",\"ts\":";
+        appendMicros(json, event.start - std::min(event.start, origin));
+        json += ",\"dur\":";
+        appendMicros(json, event.duration);
+        json += ",\"pid\":1,\"tid\":" + std::to_string(event.thread) + "}";
+    }
+    for (const CounterSample& sample : samples) {
+        json += ",\n{\"name\":\"counters\",\"ph\":\"C\",\"ts\":";
+        appendMicros(json, sample.time - std::min(sample.time, origin));
+        json += ",\"pid\":1,\"args\":{";
+        for (size_t i = 0; i < kCounters; ++i) {
+            if (i > 0) json += ',';
+            json += '"';
+            json += name(static_cast<Counter>(i));
+            json += "\":" + std::to_string(sample.values[i]);
+        }
+        json += "}}";
+    }
+    json += "\n],\"displayTimeUnit\":\"ns\"}\n";
+    out << json;
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    writeChromeTrace(out);
+    return static_cast<bool>(out.flush());
+}
+
+void report(std::ostream& out) {
+    char line[160];
+    out << "Counters:\n";
+    for (size_t i = 0; i < kCounters; ++i) {
+        snprintf(line, sizeof(line), "  %-22s %" PRIu64 "\n", name(static_cast<Counter>(i)),
+                 value(static_cast<Counter>(i)));
+        out << line;
+    }
+
+    std::vector<const Site*> sites;
+    {
+        Registry& registry = Registry::get();
+        std::lock_guard lock(registry.mutex);
+        sites = registry.sites;
+    }
+    std::sort(sites.begin(), sites.end(), [](const Site* a, const Site* b) { return a->total() > b->total(); });
+
+    out << "Sites (timers in microseconds):\n";
+    snprintf(line, sizeof(line), "  %-44s %10s %12s %10s %10s\n", "name", "count", "total", "p50", "p99");
+    out << line;
+    for (const Site* site : sites) {
+        LatencyHistogram histogram;
+        histogram.merge(site->histogram());  // Consistent copy of a live histogram
+        if (histogram.count() == 0) continue;
+        double scale = site->kind() == Site::Kind::Timer ? 1e-3 : 1.0;
+        snprintf(line, sizeof(line), "  %-44s %10" PRIu64 " %12.1f %10.1f %10.1f\n", site->name(), histogram.count(),
+                 static_cast<double>(site->total()) * scale, static_cast<double>(histogram.percentile(0.5)) * scale,
+                 static_cast<double>(histogram.percentile(0.99)) * scale);
+        out << line;
+    }
+}
+
+} // namespace logging::trace
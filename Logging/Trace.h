@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "LatencyHistogram.h"
+
+// Hot-path instrumentation. The macros below are the only intended entry
+// points in library code; unless the build defines LOGGING_TRACE (CMake
+// option ENABLE_TRACING) they expand to nothing, so an uninstrumented build
+// pays neither for the clock reads nor for the static sites.
+//
+//   TRACE_SCOPE("FileReader::forEachLine");   // Timer for the enclosing block
+//   TRACE_COUNT(BytesRead, n);                // Add n to a global counter
+//   TRACE_VALUE("pipeline.batch_lines", n);   // Record n in a histogram
+//
+// Every site keeps a LatencyHistogram and a running total. While recording
+// (start() .. stop()) each finished scope is also appended to its thread's
+// event buffer, and writeChromeTrace() turns the buffers into Chrome trace
+// JSON, which chrome://tracing and ui.perfetto.dev open directly.
+namespace logging::trace {
+
+enum class Counter : uint8_t { BytesRead, LinesProcessed, RejectedFilenames, Allocations };
+constexpr size_t kCounters = 4;
+
+const char* name(Counter counter);
+
+// Relaxed increment of a process-wide counter; safe from any thread,
+// including inside operator new
+void add(Counter counter, uint64_t amount);
+uint64_t value(Counter counter);
+std::array<uint64_t, kCounters> counters();
+
+// One instrumented place in the code. Sites are static objects created by
+// the macros and live for the whole program.
+class Site {
+public:
+    enum class Kind : uint8_t { Timer, Value };
+
+    explicit Site(const char* name, Kind kind = Kind::Timer);
+    Site(const Site&) = delete;
+    Site& operator=(const Site&) = delete;
+
+    void record(uint64_t value) {
+        histogram_.record(value);
+        total_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    const char* name() const { return name_; }
+    Kind kind() const { return kind_; }
+    const LatencyHistogram& histogram() const { return histogram_; }
+    uint64_t total() const { return total_.load(std::memory_order_relaxed); }
+
+private:
+    const char* name_;
+    Kind kind_;
+    LatencyHistogram histogram_;
+    std::atomic<uint64_t> total_{0};
+};
+
+// Times its lifetime into a Timer site
+class Scope {
+public:
+    explicit Scope(Site& site);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Site& site_;
+    uint64_t start_;
+};
+
+// Event capture for the Chrome trace; histograms and counters are always on
+void start();  // Discards earlier events
+void stop();
+bool recording();
+
+// {"traceEvents":[...]}: one complete ("X") event per scope, counter ("C")
+// samples taken whenever a thread leaves its outermost scope, and thread
+// names. Returns false if the file cannot be written.
+void writeChromeTrace(std::ostream& out);
+bool writeChromeTrace(const std::string& path);
+
+// Counters, then one line per site: count, total, p50, p99
+void report(std::ostream& out);
+
+} // namespace logging::trace
+
+#ifdef LOGGING_TRACE
+#define LOGGING_TRACE_CONCAT_(a, b) a##b
+#define LOGGING_TRACE_CONCAT(a, b) LOGGING_TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name)                                                              \
+    static ::logging::trace::Site LOGGING_TRACE_CONCAT(traceSite_, __LINE__){name};    \
+    ::logging::trace::Scope LOGGING_TRACE_CONCAT(traceScope_, __LINE__){LOGGING_TRACE_CONCAT(traceSite_, __LINE__)}
+#define TRACE_COUNT(counter, amount) ::logging::trace::add(::logging::trace::Counter::counter, (amount))
+#define TRACE_VALUE(name, value)                                                                          \
+    do {                                                                                                  \
+        static ::logging::trace::Site traceSite_{name, ::logging::trace::Site::Kind::Value};              \
+        traceSite_.record(value);                                                                         \
+    } while (0)
+#else
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#define TRACE_COUNT(counter, amount) static_cast<void>(0)
+#define TRACE_VALUE(name, value) static_cast<void>(0)
+#endif
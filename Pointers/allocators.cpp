@@ -0,0 +1,120 @@
+#include "allocators.h"
+
+#include <cstdint>
+#include <new>
+
+namespace ptrdemo {
+
+namespace {
+
+constexpr size_t alignUp(size_t n, size_t alignment) {
+    return (n + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+MonotonicArena::MonotonicArena(size_t initialChunk, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), nextChunk_(initialChunk < 1024 ? 1024 : initialChunk) {
+}
+
+MonotonicArena::~MonotonicArena() {
+    release();
+}
+
+void MonotonicArena::release() {
+    while (chunks_) {
+        Chunk* next = chunks_->next;
+        upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+        chunks_ = next;
+    }
+    cursor_ = end_ = nullptr;
+    used_ = reserved_ = 0;
+}
+
+void* MonotonicArena::do_allocate(size_t bytes, size_t alignment) {
+    auto current = reinterpret_cast<uintptr_t>(cursor_);
+    uintptr_t aligned = alignUp(current, alignment);
+    if (!cursor_ || aligned + bytes > reinterpret_cast<uintptr_t>(end_)) {
+        // New chunk: at least double the last one, and big enough for this request
+        size_t header = alignUp(sizeof(Chunk), alignof(std::max_align_t));
+        size_t size = nextChunk_;
+        while (size < header + bytes + alignment) size *= 2;
+        auto* chunk = static_cast<Chunk*>(upstream_->allocate(size, alignof(std::max_align_t)));
+        chunk->next = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+        cursor_ = reinterpret_cast<char*>(chunk) + header;
+        end_ = reinterpret_cast<char*>(chunk) + size;
+        reserved_ += size;
+        nextChunk_ = size * 2;
+        aligned = alignUp(reinterpret_cast<uintptr_t>(cursor_), alignment);
+    }
+    cursor_ = reinterpret_cast<char*>(aligned + bytes);
+    used_ += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+FixedBlockPool::FixedBlockPool(size_t blockSize, size_t blocksPerChunk, std::pmr::memory_resource* upstream)
+    : upstream_(upstream),
+      blockSize_(alignUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize, alignof(std::max_align_t))),
+      blocksPerChunk_(blocksPerChunk ? blocksPerChunk : 1) {
+}
+
+FixedBlockPool::~FixedBlockPool() {
+    size_t chunkBytes = alignof(std::max_align_t) + blockSize_ * blocksPerChunk_;
+    while (chunks_) {
+        void* next = *static_cast<void**>(chunks_);
+        upstream_->deallocate(chunks_, chunkBytes, alignof(std::max_align_t));
+        chunks_ = next;
+    }
+}
+
+void FixedBlockPool::grow() {
+    // First max_align_t slot links the chunks; blocks follow and are carved
+    // lazily, so untouched blocks never fault their pages in
+    size_t chunkBytes = alignof(std::max_align_t) + blockSize_ * blocksPerChunk_;
+    char* chunk = static_cast<char*>(upstream_->allocate(chunkBytes, alignof(std::max_align_t)));
+    *reinterpret_cast<void**>(chunk) = chunks_;
+    chunks_ = chunk;
+    reserved_ += chunkBytes;
+    fresh_ = chunk + alignof(std::max_align_t);
+    freshEnd_ = chunk + chunkBytes;
+}
+
+void* FixedBlockPool::do_allocate(size_t bytes, size_t alignment) {
+    if (bytes > blockSize_ || alignment > alignof(std::max_align_t)) {
+        return upstream_->allocate(bytes, alignment);
+    }
+    ++inUse_;
+    if (free_) {
+        FreeBlock* block = free_;
+        free_ = block->next;
+        return block;
+    }
+    if (fresh_ == freshEnd_) grow();
+    void* block = fresh_;
+    fresh_ += blockSize_;
+    return block;
+}
+
+void FixedBlockPool::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    if (bytes > blockSize_ || alignment > alignof(std::max_align_t)) {
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+    }
+    auto* block = static_cast<FreeBlock*>(p);
+    block->next = free_;
+    free_ = block;
+    --inUse_;
+}
+
+ResourcePtr<int> makeSafeInt(std::pmr::memory_resource& resource) {
+    void* storage = resource.allocate(sizeof(int), alignof(int));
+    return ResourcePtr<int>(new (storage) int(42), ResourceDeleter<int>{&resource});
+}
+
+std::shared_ptr<std::pmr::string> makeSharedString(const std::string& s, std::pmr::memory_resource& resource) {
+    return std::allocate_shared<std::pmr::string>(std::pmr::polymorphic_allocator<std::pmr::string>(&resource), s);
+}
+
+} // namespace ptrdemo
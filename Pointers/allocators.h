@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+namespace ptrdemo {
+
+// GOOD: bump-pointer arena. Allocation is a pointer increment; individual
+// deallocation is a no-op and everything is released at once (release() or
+// destruction). Chunks grow geometrically from the upstream resource.
+// Not thread-safe: use one arena per thread or per request.
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(size_t initialChunk = 64 * 1024,
+                            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~MonotonicArena() override;
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // Frees every chunk; all memory handed out becomes invalid
+    void release();
+
+    size_t bytesAllocated() const { return used_; }
+    size_t bytesReserved() const { return reserved_; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;  // Including this header
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream_;
+    Chunk* chunks_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    size_t nextChunk_;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+};
+
+// GOOD: fixed-size block pool with an intrusive free list. Requests that
+// fit the block size are served from the list (O(1), no per-object
+// header); larger ones go to the upstream resource. Not thread-safe.
+class FixedBlockPool : public std::pmr::memory_resource {
+public:
+    FixedBlockPool(size_t blockSize, size_t blocksPerChunk = 1024,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~FixedBlockPool() override;
+
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    size_t blockSize() const { return blockSize_; }
+    size_t blocksInUse() const { return inUse_; }
+    size_t bytesReserved() const { return reserved_; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    void grow();
+
+    std::pmr::memory_resource* upstream_;
+    size_t blockSize_;
+    size_t blocksPerChunk_;
+    FreeBlock* free_ = nullptr;   // Returned blocks
+    char* fresh_ = nullptr;       // Never-used blocks in the newest chunk
+    char* freshEnd_ = nullptr;
+    void* chunks_ = nullptr;      // Singly linked through each chunk's first word
+    size_t inUse_ = 0;
+    size_t reserved_ = 0;
+};
+
+// Deleter for objects placed in a memory_resource
+template <typename T>
+struct ResourceDeleter {
+    std::pmr::memory_resource* resource;
+
+    void operator()(T* p) const {
+        p->~T();
+        resource->deallocate(p, sizeof(T), alignof(T));
+    }
+};
+
+template <typename T>
+using ResourcePtr = std::unique_ptr<T, ResourceDeleter<T>>;
+
+// GOOD: unique ownership, storage from the given arena or pool
+ResourcePtr<int> makeSafeInt(std::pmr::memory_resource& resource);
+
+// GOOD: shared ownership; control block, string object and characters
+// all come from the given resource (allocate_shared + pmr::string)
+std::shared_ptr<std::pmr::string> makeSharedString(const std::string& s, std::pmr::memory_resource& resource);
+
+} // namespace ptrdemo
@@ -0,0 +1,263 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bounds checks are on in debug and sanitizer builds and compile away in
+// release builds; define PTRDEMO_BOUNDS_CHECK to 0 or 1 to force either.
+#ifndef PTRDEMO_BOUNDS_CHECK
+#if defined(__SANITIZE_ADDRESS__)
+#define PTRDEMO_BOUNDS_CHECK 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define PTRDEMO_BOUNDS_CHECK 1
+#endif
+#endif
+#endif
+#ifndef PTRDEMO_BOUNDS_CHECK
+#ifdef NDEBUG
+#define PTRDEMO_BOUNDS_CHECK 0
+#else
+#define PTRDEMO_BOUNDS_CHECK 1
+#endif
+#endif
+
+namespace ptrdemo {
+
+[[noreturn]] inline void boundsFailure(size_t index, size_t size) {
+    std::fprintf(stderr, "ptrdemo: index %zu out of range (size %zu)\n", index, size);
+    std::abort();
+}
+
+inline constexpr void checkIndex([[maybe_unused]] size_t index, [[maybe_unused]] size_t size) {
+#if PTRDEMO_BOUNDS_CHECK
+    if (index >= size) boundsFailure(index, size);
+#endif
+}
+
+// GOOD: non-owning view with debug-only bounds checks. operator[] is a
+// checked access in debug builds and raw indexing in release; iterating
+// with range-for uses plain pointers, so the loop itself never checks.
+template <typename T>
+class CheckedSpan {
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr CheckedSpan() = default;
+    constexpr CheckedSpan(T* data, size_t size) : data_(data), size_(size) {}
+    template <size_t N>
+    constexpr CheckedSpan(T (&array)[N]) : data_(array), size_(N) {}
+    template <typename Container>
+        requires requires(Container& c) { c.data(); c.size(); }
+    constexpr CheckedSpan(Container& c) : data_(c.data()), size_(c.size()) {}
+
+    constexpr T& operator[](size_t index) const {
+        checkIndex(index, size_);
+        return data_[index];
+    }
+
+    constexpr T* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr iterator begin() const { return data_; }
+    constexpr iterator end() const { return data_ + size_; }
+
+    // One check for the whole range instead of one per element
+    constexpr CheckedSpan subspan(size_t offset, size_t count) const {
+        // offset + count could wrap; compare against what is left instead
+        checkIndex(offset, size_ + 1);
+        checkIndex(count, size_ - offset + 1);
+        return CheckedSpan(data_ + offset, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// GOOD: vector with inline storage for the first InlineCapacity elements,
+// so small arrays never touch the heap, and the same debug-only bounds
+// checks as CheckedSpan. Spills to the heap (doubling) when it outgrows
+// the inline buffer.
+template <typename T, size_t InlineCapacity>
+class SmallVector {
+    static_assert(InlineCapacity > 0, "use std::vector for no inline storage");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values) {
+        reserve(values.size());
+        for (const T& v : values) push_back(v);
+    }
+
+    SmallVector(const SmallVector& other) {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        moveFrom(std::move(other));
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            clear();
+            releaseHeap();
+            moveFrom(std::move(copy));
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            moveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    T& operator[](size_t index) {
+        checkIndex(index, size_);
+        return data_[index];
+    }
+    const T& operator[](size_t index) const {
+        checkIndex(index, size_);
+        return data_[index];
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) return growAndEmplace(std::forward<Args>(args)...);
+        T* slot = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        checkIndex(0, size_);
+        data_[--size_].~T();
+    }
+
+    void clear() {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) grow(capacity);
+    }
+
+    void resize(size_t size) {
+        reserve(size);
+        while (size_ < size) emplace_back();
+        while (size_ > size) pop_back();
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool isInline() const { return data_ == inlineData(); }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    operator CheckedSpan<T>() { return CheckedSpan<T>(data_, size_); }
+    operator CheckedSpan<const T>() const { return CheckedSpan<const T>(data_, size_); }
+
+private:
+    T* inlineData() { return reinterpret_cast<T*>(inline_); }
+    const T* inlineData() const { return reinterpret_cast<const T*>(inline_); }
+
+    void grow(size_t capacity) {
+        capacity = std::max(capacity, InlineCapacity * 2);
+        T* fresh = std::allocator<T>().allocate(capacity);
+        std::uninitialized_move(data_, data_ + size_, fresh);
+        std::destroy(data_, data_ + size_);
+        releaseHeap();
+        data_ = fresh;
+        capacity_ = capacity;
+    }
+
+    // args may refer to an element (v.push_back(v[0])), so the new element
+    // is built in the fresh buffer before the old ones move out
+    template <typename... Args>
+    T& growAndEmplace(Args&&... args) {
+        size_t capacity = std::max(capacity_ * 2, InlineCapacity * 2);
+        T* fresh = std::allocator<T>().allocate(capacity);
+        T* slot;
+        try {
+            slot = ::new (static_cast<void*>(fresh + size_)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            std::allocator<T>().deallocate(fresh, capacity);
+            throw;
+        }
+        try {
+            std::uninitialized_move(data_, data_ + size_, fresh);
+        } catch (...) {
+            slot->~T();
+            std::allocator<T>().deallocate(fresh, capacity);
+            throw;
+        }
+        std::destroy(data_, data_ + size_);
+        releaseHeap();
+        data_ = fresh;
+        capacity_ = capacity;
+        ++size_;
+        return *slot;
+    }
+
+    void releaseHeap() {
+        if (!isInline()) std::allocator<T>().deallocate(data_, capacity_);
+        data_ = inlineData();
+        capacity_ = InlineCapacity;
+    }
+
+    // Steals a heap buffer, or moves inline elements one by one
+    void moveFrom(SmallVector&& other) {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            other.data_ = other.inlineData();
+            other.capacity_ = InlineCapacity;
+            other.size_ = 0;
+        }
+    }
+
+    alignas(T) unsigned char inline_[InlineCapacity * sizeof(T)];
+    T* data_ = inlineData();
+    size_t size_ = 0;
+    size_t capacity_ = InlineCapacity;
+};
+
+} // namespace ptrdemo
@@ -1,4 +1,9 @@
 #include "pointers.h"
+#include "allocators.h"
+#include "../Sorting/Sorting.h"
+#include "../Logging/Trace.h"
+#include <algorithm>
+#include <stdexcept>
 
 namespace ptrdemo {
 
@@ -30,6 +35,7 @@ void rawArrayWriteBad() {
 }
 
 void vectorWriteGood() {
+    TRACE_SCOPE("ptrdemo::vectorWriteGood");
     std::vector<int> v(3);
     for (size_t i = 0; i < v.size(); ++i) {
         v[i] = static_cast<int>(i);
@@ -48,6 +54,10 @@ std::shared_ptr<std::string> makeSharedString(const std::string& s) {
     return std::make_shared<std::string>(s);
 }
 
+SharedString makeIntrusiveString(const std::string& s) {
+    return SharedString(s);
+}
+
 void observe(const int* p) {
     if (p) std::cout << "Observed: " << *p << '\n';
 }
@@ -66,6 +76,7 @@ void checkedDereferenceGood(int* p) {
 }
 
 void oldStyleArrayBad() {
+    TRACE_SCOPE("ptrdemo::oldStyleArrayBad");
     std::cout << "\n=== OLD STYLE ARRAY (BAD) ===\n";
     
     // Problem 1: Fixed size
@@ -92,6 +103,7 @@ void oldStyleArrayBad() {
 }
 
 void modernVectorGood() {
+    TRACE_SCOPE("ptrdemo::modernVectorGood");
     std::cout << "\n=== MODERN VECTOR (GOOD) ===\n";
     
     // Advantage 1: Dynamic size
@@ -124,7 +136,33 @@ void modernVectorGood() {
     std::cout << '\n';
 }
 
+void checkedSpanGood() {
+    TRACE_SCOPE("ptrdemo::checkedSpanGood");
+    std::cout << "\n=== CHECKED SPAN + SMALL VECTOR (GOOD) ===\n";
+
+    // Inline storage: the first 8 elements never touch the heap
+    SmallVector<int, 8> small;
+    for (int i = 0; i < 8; ++i) small.push_back(i * 10);
+    std::cout << "SmallVector size " << small.size()
+              << (small.isInline() ? " (inline)" : " (heap)") << '\n';
+
+    // Same view over a vector, a SmallVector or a plain array; v[i] is
+    // checked in debug builds and raw indexing in release builds
+    int arr[3] = {1, 2, 3};
+    CheckedSpan<int> view(arr);
+    view[2] = 30;
+    // view[3] = 40;  // Debug: aborts with "index 3 out of range (size 3)"
+
+    // Range-for walks plain pointers: no per-element checks at all
+    long total = 0;
+    for (int x : CheckedSpan<const int>(small)) total += x;
+    for (int x : view) total += x;
+    std::cout << "Checked sum: " << total
+              << (PTRDEMO_BOUNDS_CHECK ? " (bounds checks on)" : " (bounds checks off)") << '\n';
+}
+
 void vectorRangeExample() {
+    TRACE_SCOPE("ptrdemo::vectorRangeExample");
     std::cout << "\n=== VECTOR RANGE OPERATIONS ===\n";
     
     std::vector<int> v1 = {1, 2, 3};
@@ -140,6 +178,22 @@ void vectorRangeExample() {
     std::cout << "After merge: ";
     for (int x : v1) std::cout << x << ' ';
     std::cout << '\n';
+
+    // Merge presorted runs straight into their destination, no insert + sort
+    std::vector<int> r1 = {1, 4, 9}, r2 = {2, 3, 10}, r3 = {5, 6, 7};
+    std::vector<std::span<const int>> runs = {r1, r2, r3};
+    std::vector<int> merged(r1.size() + r2.size() + r3.size());
+    sorting::kWayMerge<int>(runs, merged);
+    std::cout << "k-way merge: ";
+    for (int x : merged) std::cout << x << ' ';
+    std::cout << '\n';
+
+    // Radix sort: linear time for integer keys
+    std::vector<int> unsorted = {42, -7, 1000, 0, -7, 13};
+    sorting::radixSort<int>(unsorted);
+    std::cout << "Radix sorted: ";
+    for (int x : unsorted) std::cout << x << ' ';
+    std::cout << '\n';
     
     // Reserve capacity for performance
     std::vector<int> v3;
@@ -151,6 +205,7 @@ void vectorRangeExample() {
 }
 
 void runAllSafe() {
+    TRACE_SCOPE("ptrdemo::runAllSafe");
     auto up = makeSafeInt();
     std::cout << "unique_ptr value: " << *up << '\n';
 
@@ -161,12 +216,25 @@ void runAllSafe() {
     // Add the new examples
     oldStyleArrayBad();
     modernVectorGood();
+    checkedSpanGood();
     vectorRangeExample();
 
     auto sp1 = makeSharedString("hello");
     auto sp2 = sp1;
     std::cout << "shared_ptr use_count: " << sp1.use_count() << '\n';
 
+    auto is1 = makeIntrusiveString("hello from a single allocation");
+    auto is2 = is1;
+    std::cout << "SharedString use_count: " << is1.useCount() << '\n';
+
+    // Same ownership patterns with storage from an arena and a pool
+    MonotonicArena arena;
+    FixedBlockPool pool(64);
+    auto arenaInt = makeSafeInt(arena);
+    auto poolString = makeSharedString("pooled hello", pool);
+    std::cout << "arena int: " << *arenaInt << ", pool string: " << *poolString
+              << " (" << pool.blocksInUse() << " pool blocks in use)\n";
+
     int local = 9;
     observe(&local);
 
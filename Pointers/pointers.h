@@ -3,6 +3,8 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include "shared_string.h"
+#include "checked_span.h"
 
 namespace ptrdemo {
 
@@ -30,6 +32,9 @@ void doubleDeleteBad();
 // GOOD: shared ownership demo
 std::shared_ptr<std::string> makeSharedString(const std::string& s);
 
+// GOOD: shared ownership, count and characters in one allocation
+SharedString makeIntrusiveString(const std::string& s);
+
 // GOOD: non-owning raw pointer (observer) usage pattern
 void observe(const int* p);
 
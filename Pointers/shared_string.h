@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ptrdemo {
+
+// GOOD: immutable, reference-counted string handle in a single allocation.
+// shared_ptr<string> (makeSharedString) needs a control block plus the
+// string's own character buffer, and every copy is an atomic increment.
+// Here the count and characters share one block, and strings of up to 15
+// bytes live inline in the 16-byte handle (copies are a plain memcpy).
+//
+// Atomic = true is safe to share across threads; Atomic = false uses a
+// plain counter for data confined to one thread.
+template <bool Atomic>
+class BasicSharedString {
+public:
+    static constexpr size_t inlineCapacity = 15;
+
+    BasicSharedString() noexcept { setInline(0); }
+
+    explicit BasicSharedString(std::string_view text) {
+        if (text.size() <= inlineCapacity) {
+            std::memcpy(bytes_, text.data(), text.size());
+            bytes_[text.size()] = '\0';
+            setInline(text.size());
+            return;
+        }
+        void* raw = ::operator new(sizeof(Block) + text.size() + 1);
+        Block* block = new (raw) Block{text.size()};
+        std::memcpy(block->chars(), text.data(), text.size());
+        block->chars()[text.size()] = '\0';
+        setHeap(block);
+    }
+
+    BasicSharedString(const BasicSharedString& other) noexcept {
+        std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+        if (isHeap()) heap()->acquire();
+    }
+
+    BasicSharedString(BasicSharedString&& other) noexcept {
+        std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+        other.setInline(0);
+    }
+
+    BasicSharedString& operator=(BasicSharedString other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~BasicSharedString() {
+        if (isHeap()) heap()->release();
+    }
+
+    void swap(BasicSharedString& other) noexcept {
+        char tmp[sizeof(bytes_)];
+        std::memcpy(tmp, bytes_, sizeof(bytes_));
+        std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+        std::memcpy(other.bytes_, tmp, sizeof(bytes_));
+    }
+
+    std::string_view view() const noexcept {
+        return isHeap() ? std::string_view(heap()->chars(), heap()->size)
+                        : std::string_view(bytes_, inlineCapacity - static_cast<size_t>(bytes_[kTag]));
+    }
+    const char* c_str() const noexcept { return isHeap() ? heap()->chars() : bytes_; }
+    size_t size() const noexcept { return view().size(); }
+    bool empty() const noexcept { return size() == 0; }
+    operator std::string_view() const noexcept { return view(); }
+
+    // Owners of the shared block (1 for inline strings, which are never shared)
+    long useCount() const noexcept { return isHeap() ? heap()->count() : 1; }
+
+    friend bool operator==(const BasicSharedString& a, const BasicSharedString& b) { return a.view() == b.view(); }
+    friend bool operator==(const BasicSharedString& a, std::string_view b) { return a.view() == b; }
+
+private:
+    using Counter = std::conditional_t<Atomic, std::atomic<uint32_t>, uint32_t>;
+
+    // Heap block: count, size, then the characters and a terminator
+    struct Block {
+        explicit Block(size_t n) : refs(1), size(n) {}
+
+        char* chars() { return reinterpret_cast<char*>(this + 1); }
+
+        void acquire() {
+            if constexpr (Atomic) refs.fetch_add(1, std::memory_order_relaxed);
+            else ++refs;
+        }
+
+        void release() {
+            bool last;
+            if constexpr (Atomic) last = refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            else last = --refs == 0;
+            if (last) {
+                this->~Block();
+                ::operator delete(this);
+            }
+        }
+
+        long count() const {
+            if constexpr (Atomic) return static_cast<long>(refs.load(std::memory_order_relaxed));
+            else return static_cast<long>(refs);
+        }
+
+        Counter refs;
+        size_t size;
+    };
+
+    // Last byte tags the mode: unused inline capacity (15 - length), which
+    // doubles as the terminator of a full 15-byte string, or kHeapTag
+    static constexpr size_t kTag = 15;
+    static constexpr char kHeapTag = static_cast<char>(0x80);
+
+    bool isHeap() const noexcept { return bytes_[kTag] == kHeapTag; }
+    Block* heap() const noexcept {
+        Block* block;
+        std::memcpy(&block, bytes_, sizeof(block));
+        return block;
+    }
+    void setInline(size_t size) noexcept {
+        bytes_[size] = '\0';
+        bytes_[kTag] = static_cast<char>(inlineCapacity - size);
+    }
+    void setHeap(Block* block) noexcept {
+        std::memcpy(bytes_, &block, sizeof(block));
+        bytes_[kTag] = kHeapTag;
+    }
+
+    alignas(8) char bytes_[16];
+};
+
+using SharedString = BasicSharedString<true>;
+using LocalSharedString = BasicSharedString<false>;
+
+static_assert(sizeof(SharedString) == 16);
+
+} // namespace ptrdemo
@@ -0,0 +1,272 @@
+#include "Sorting.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sorting {
+
+namespace {
+
+// Below this many elements std::sort beats the radix histogram setup
+constexpr size_t kSmallSort = 256;
+
+template <typename T>
+using Key = std::make_unsigned_t<T>;
+
+// Order-preserving map to unsigned: flipping the sign bit puts negative
+// values below positive ones
+template <typename T>
+inline Key<T> toKey(T value) {
+    Key<T> key = static_cast<Key<T>>(value);
+    if constexpr (std::is_signed_v<T>) key ^= Key<T>(1) << (sizeof(T) * 8 - 1);
+    return key;
+}
+
+template <typename T>
+inline T fromKey(Key<T> key) {
+    if constexpr (std::is_signed_v<T>) key ^= Key<T>(1) << (sizeof(T) * 8 - 1);
+    return static_cast<T>(key);
+}
+
+} // namespace
+
+template <SortKey T>
+void radixSort(std::span<T> data, std::span<T> scratch) {
+    const size_t n = data.size();
+    if (n < kSmallSort) {
+        std::sort(data.begin(), data.end());
+        return;
+    }
+    if (scratch.size() < n) throw std::invalid_argument("radixSort: scratch smaller than data");
+
+    // Presorted input is common and is the radix worst case: the bucket
+    // write streams end up a power of two apart and alias in the cache
+    if (std::is_sorted(data.begin(), data.end())) return;
+    if (std::is_sorted(data.begin(), data.end(), std::greater<T>())) {
+        std::reverse(data.begin(), data.end());
+        return;
+    }
+
+    constexpr size_t kDigits = sizeof(T);
+    std::array<std::array<size_t, 256>, kDigits> counts{};
+    for (T value : data) {
+        Key<T> key = toKey(value);
+        for (size_t d = 0; d < kDigits; ++d) ++counts[d][(key >> (8 * d)) & 0xff];
+    }
+
+    T* src = data.data();
+    T* dst = scratch.data();
+    for (size_t d = 0; d < kDigits; ++d) {
+        const auto& count = counts[d];
+        // Every element has the same digit here: the pass would be a copy
+        if (count[(toKey(src[0]) >> (8 * d)) & 0xff] == n) continue;
+
+        std::array<size_t, 256> offset;
+        size_t sum = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            offset[b] = sum;
+            sum += count[b];
+        }
+        for (size_t i = 0; i < n; ++i) {
+            T value = src[i];
+            dst[offset[(toKey(value) >> (8 * d)) & 0xff]++] = value;
+        }
+        std::swap(src, dst);
+    }
+    if (src != data.data()) std::copy(src, src + n, data.data());
+}
+
+template <SortKey T>
+void radixSort(std::span<T> data) {
+    if (data.size() < kSmallSort) {
+        std::sort(data.begin(), data.end());
+        return;
+    }
+    auto scratch = std::make_unique_for_overwrite<T[]>(data.size());
+    radixSort(data, std::span<T>(scratch.get(), data.size()));
+}
+
+template <SortKey T>
+void kWayMerge(std::span<const std::span<const T>> runs, std::span<T> out) {
+    size_t total = 0;
+    for (const auto& run : runs) total += run.size();
+    if (total != out.size()) throw std::invalid_argument("kWayMerge: output size differs from the runs' total");
+
+    const size_t k = runs.size();
+    if (k == 0) return;
+    if (k == 1) {
+        std::copy(runs[0].begin(), runs[0].end(), out.begin());
+        return;
+    }
+    if (k == 2) {
+        std::merge(runs[0].begin(), runs[0].end(), runs[1].begin(), runs[1].end(), out.begin());
+        return;
+    }
+
+    // Each run's current head is cached next to its tie-break order, so a
+    // match never touches the runs themselves. An exhausted run's head
+    // becomes the maximum with order >= k: it loses to every live element,
+    // including real maximum values.
+    std::vector<const T*> pos(k), end(k);
+    std::vector<T> head(k);
+    std::vector<size_t> order(k);
+    for (size_t r = 0; r < k; ++r) {
+        pos[r] = runs[r].data();
+        end[r] = runs[r].data() + runs[r].size();
+        bool empty = pos[r] == end[r];
+        head[r] = empty ? std::numeric_limits<T>::max() : *pos[r];
+        order[r] = empty ? r + k : r;
+    }
+    auto less = [&](size_t a, size_t b) {
+        return (head[a] < head[b]) | ((head[a] == head[b]) & (order[a] < order[b]));
+    };
+
+    // Heap layout: leaves k..2k-1 are the runs, node n plays 2n against
+    // 2n+1 and keeps the loser; tree[0] holds the overall winner
+    std::vector<size_t> tree(k), winner(2 * k);
+    for (size_t r = 0; r < k; ++r) winner[k + r] = r;
+    for (size_t node = k - 1; node >= 1; --node) {
+        size_t a = winner[2 * node];
+        size_t b = winner[2 * node + 1];
+        bool aWins = less(a, b);
+        winner[node] = aWins ? a : b;
+        tree[node] = aWins ? b : a;
+    }
+    tree[0] = winner[1];
+
+    T* o = out.data();
+    for (size_t i = 0; i < total; ++i) {
+        size_t w = tree[0];
+        *o++ = head[w];
+        if (++pos[w] != end[w]) {
+            head[w] = *pos[w];
+        } else {
+            head[w] = std::numeric_limits<T>::max();
+            order[w] = w + k;
+        }
+        // Replay only the path from w's leaf to the root; branch-free,
+        // since on random data each match is a coin flip
+        for (size_t node = (w + k) / 2; node >= 1; node /= 2) {
+            size_t challenger = tree[node];
+            bool swap = less(challenger, w);
+            tree[node] = swap ? w : challenger;
+            w = swap ? challenger : w;
+        }
+        tree[0] = w;
+    }
+}
+
+template <SortKey T>
+std::vector<size_t> splitRuns(std::span<const std::span<const T>> runs, size_t rank) {
+    std::vector<size_t> split(runs.size(), 0);
+    size_t total = 0;
+    for (const auto& run : runs) total += run.size();
+    if (rank == 0) return split;
+    if (rank >= total) {
+        for (size_t r = 0; r < runs.size(); ++r) split[r] = runs[r].size();
+        return split;
+    }
+
+    // Bisect on the key for the rank-th smallest value v
+    Key<T> lo = std::numeric_limits<Key<T>>::max();
+    Key<T> hi = 0;
+    for (const auto& run : runs) {
+        if (run.empty()) continue;
+        lo = std::min(lo, toKey(run.front()));
+        hi = std::max(hi, toKey(run.back()));
+    }
+    while (lo < hi) {
+        Key<T> mid = lo + (hi - lo) / 2;
+        size_t atMost = 0;
+        for (const auto& run : runs) atMost += std::upper_bound(run.begin(), run.end(), fromKey<T>(mid)) - run.begin();
+        if (atMost > rank) hi = mid;
+        else lo = mid + 1;
+    }
+    const T v = fromKey<T>(lo);
+
+    // Everything below v, then copies of v from the earliest runs
+    size_t taken = 0;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        split[r] = std::lower_bound(runs[r].begin(), runs[r].end(), v) - runs[r].begin();
+        taken += split[r];
+    }
+    size_t need = rank - taken;
+    for (size_t r = 0; r < runs.size() && need > 0; ++r) {
+        size_t equal = std::upper_bound(runs[r].begin(), runs[r].end(), v) - runs[r].begin() - split[r];
+        size_t take = std::min(need, equal);
+        split[r] += take;
+        need -= take;
+    }
+    return split;
+}
+
+ParallelSorter::ParallelSorter() : ParallelSorter(Options{}) {}
+
+ParallelSorter::ParallelSorter(Options options) : options_(options), pool_(options.threads) {}
+
+template <SortKey T>
+void ParallelSorter::sort(std::span<T> data) {
+    const size_t n = data.size();
+    const size_t parts = pool_.size();
+    if (n < options_.serialCutoff || parts < 2) {
+        radixSort(data);
+        return;
+    }
+
+    auto scratch = std::make_unique_for_overwrite<T[]>(n);
+    T* buffer = scratch.get();
+    auto sliceBegin = [&](size_t p) { return n * p / parts; };
+
+    // 1. One run per worker, each radix-sorted in place
+    std::vector<std::span<const T>> runs(parts);
+    for (size_t p = 0; p < parts; ++p) {
+        size_t begin = sliceBegin(p);
+        size_t length = sliceBegin(p + 1) - begin;
+        runs[p] = std::span<const T>(data.data() + begin, length);
+        pool_.submit([=] { radixSort(std::span<T>(data.data() + begin, length), std::span<T>(buffer + begin, length)); });
+    }
+    pool_.wait();
+
+    // 2. Each worker merges the elements of rank [begin, end) into the
+    //    same range of the scratch buffer
+    std::span<const std::span<const T>> allRuns(runs);
+    for (size_t p = 0; p < parts; ++p) {
+        pool_.submit([=] {
+            size_t begin = sliceBegin(p);
+            size_t end = sliceBegin(p + 1);
+            std::vector<size_t> from = splitRuns<T>(allRuns, begin);
+            std::vector<size_t> to = splitRuns<T>(allRuns, end);
+            std::vector<std::span<const T>> pieces;
+            for (size_t r = 0; r < parts; ++r) {
+                if (to[r] > from[r]) pieces.push_back(allRuns[r].subspan(from[r], to[r] - from[r]));
+            }
+            kWayMerge<T>(pieces, std::span<T>(buffer + begin, end - begin));
+        });
+    }
+    pool_.wait();
+
+    // 3. Copy back in parallel; memory bandwidth, not comparisons
+    for (size_t p = 0; p < parts; ++p) {
+        pool_.submit([=] { std::copy(buffer + sliceBegin(p), buffer + sliceBegin(p + 1), data.data() + sliceBegin(p)); });
+    }
+    pool_.wait();
+}
+
+#define SORTING_INSTANTIATE(T)                                                   \
+    template void radixSort<T>(std::span<T>);                                    \
+    template void radixSort<T>(std::span<T>, std::span<T>);                      \
+    template void kWayMerge<T>(std::span<const std::span<const T>>, std::span<T>); \
+    template void ParallelSorter::sort<T>(std::span<T>);                         \
+    template std::vector<size_t> splitRuns<T>(std::span<const std::span<const T>>, size_t);
+SORTING_INSTANTIATE(int32_t)
+SORTING_INSTANTIATE(uint32_t)
+SORTING_INSTANTIATE(int64_t)
+SORTING_INSTANTIATE(uint64_t)
+#undef SORTING_INSTANTIATE
+
+} // namespace sorting
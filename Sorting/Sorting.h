@@ -0,0 +1,77 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "../Concurrency/WorkStealingPool.h"
+
+// Sorting and merging for large integer arrays, beyond the std::sort and
+// vector::insert calls in the pointer demos. Instantiated for 32- and
+// 64-bit signed and unsigned integers.
+namespace sorting {
+
+template <typename T>
+concept SortKey = std::same_as<T, int32_t> || std::same_as<T, uint32_t> ||
+                  std::same_as<T, int64_t> || std::same_as<T, uint64_t>;
+
+// LSD radix sort with 8-bit digits: one counting pass builds every digit's
+// histogram, then one scatter pass per digit, skipping digits that are the
+// same in every element. Stable; O(n) time and n elements of extra memory.
+template <SortKey T>
+void radixSort(std::span<T> data);
+
+// Same, with caller-provided scratch of at least data.size() elements
+template <SortKey T>
+void radixSort(std::span<T> data, std::span<T> scratch);
+
+// Merges presorted runs straight into out (size = sum of run sizes) with a
+// loser tree: one comparison per tree level per element and no
+// intermediate buffers. Stable: equal elements keep run order.
+template <SortKey T>
+void kWayMerge(std::span<const std::span<const T>> runs, std::span<T> out);
+
+// Parallel merge sort: the input is cut into one run per worker, runs are
+// radix-sorted concurrently, then the output is split into equal slices at
+// exact rank boundaries and each worker k-way merges its slice. Every
+// element moves through one merge pass regardless of the thread count.
+class ParallelSorter {
+public:
+    struct Options {
+        size_t threads = 0;              // 0 = hardware concurrency
+        size_t serialCutoff = 1 << 16;   // Smaller inputs use radixSort directly
+    };
+
+    ParallelSorter();
+    explicit ParallelSorter(Options options);
+
+    template <SortKey T>
+    void sort(std::span<T> data);
+
+    size_t threadCount() const { return pool_.size(); }
+
+private:
+    Options options_;
+    WorkStealingPool pool_;
+};
+
+// Split points of `rank` in presorted runs: split[i] elements are taken
+// from run i, their total is rank, and none of them is greater than any
+// element left behind. Ties are taken from earlier runs first.
+template <SortKey T>
+std::vector<size_t> splitRuns(std::span<const std::span<const T>> runs, size_t rank);
+
+#define SORTING_DECLARE(T)                                                              \
+    extern template void radixSort<T>(std::span<T>);                                    \
+    extern template void radixSort<T>(std::span<T>, std::span<T>);                      \
+    extern template void kWayMerge<T>(std::span<const std::span<const T>>, std::span<T>); \
+    extern template void ParallelSorter::sort<T>(std::span<T>);                         \
+    extern template std::vector<size_t> splitRuns<T>(std::span<const std::span<const T>>, size_t);
+SORTING_DECLARE(int32_t)
+SORTING_DECLARE(uint32_t)
+SORTING_DECLARE(int64_t)
+SORTING_DECLARE(uint64_t)
+#undef SORTING_DECLARE
+
+} // namespace sorting
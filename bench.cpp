@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include "Benchmarks/Benchmarks.h"
+
+using namespace std;
+
+// Count every heap allocation so suites can report allocations per call
+void* operator new(size_t size) {
+    benchmarks::noteAllocation();
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// Usage: bench <suite> [suite args...]
+//   bench filereader [sizes...]   e.g. bench filereader 1M 100M 10G
+//   bench linescan [size]
+//   bench parallel [sizes...] [threads=N]
+//   bench filenames [count]
+//   bench sanitize [count]
+//   bench format [iterations]
+//   bench logger [threads] [messages per thread]
+//   bench checked [count]
+//   bench reduce [count]
+//   bench alloc [count]
+//   bench sharedstring [copies] [threads]
+//   bench span [elements]
+//   bench sort [sizes...] [threads=N]
+//   bench pipeline [sizes...]
+//   bench scan [size]
+//   bench compressed [size]
+//   bench follow [initial size]
+//   bench ingest [files]
+//   bench cache [distinct] [lookups]
+//   bench async [files] [file size]
+//   bench index [file size] [seeks]
+//   bench regress [file size] [--warmup=N] [--reps=N] [--json=PATH] [--filter=TEXT]
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <suite> [args...]\n"
+             << "Suites: filereader linescan parallel filenames sanitize format logger checked reduce alloc sharedstring span sort pipeline scan compressed follow ingest cache async index regress\n";
+        return 1;
+    }
+
+    string suite = argv[1];
+    vector<string> args(argv + 2, argv + argc);
+
+    if (suite == "filereader") {
+        benchmarks::runFileReaderBenchmarks(args);
+    } else if (suite == "linescan") {
+        benchmarks::runLineScannerBenchmarks(args);
+    } else if (suite == "parallel") {
+        benchmarks::runParallelReaderBenchmarks(args);
+    } else if (suite == "filenames") {
+        benchmarks::runFilenameValidatorBenchmarks(args);
+    } else if (suite == "sanitize") {
+        benchmarks::runSanitizerBenchmarks(args);
+    } else if (suite == "format") {
+        benchmarks::runFormatBenchmarks(args);
+    } else if (suite == "logger") {
+        benchmarks::runLoggerBenchmarks(args);
+    } else if (suite == "checked") {
+        benchmarks::runCheckedArithmeticBenchmarks(args);
+    } else if (suite == "reduce") {
+        benchmarks::runSpanReduceBenchmarks(args);
+    } else if (suite == "alloc") {
+        benchmarks::runAllocatorBenchmarks(args);
+    } else if (suite == "sharedstring") {
+        benchmarks::runSharedStringBenchmarks(args);
+    } else if (suite == "span") {
+        benchmarks::runCheckedSpanBenchmarks(args);
+    } else if (suite == "sort") {
+        benchmarks::runSortBenchmarks(args);
+    } else if (suite == "pipeline") {
+        benchmarks::runPipelineBenchmarks(args);
+    } else if (suite == "scan") {
+        benchmarks::runPatternScannerBenchmarks(args);
+    } else if (suite == "compressed") {
+        benchmarks::runCompressedBenchmarks(args);
+    } else if (suite == "follow") {
+        benchmarks::runFollowBenchmarks(args);
+    } else if (suite == "ingest") {
+        benchmarks::runIngestBenchmarks(args);
+    } else if (suite == "cache") {
+        benchmarks::runValidationCacheBenchmarks(args);
+    } else if (suite == "async") {
+        benchmarks::runAsyncReadBenchmarks(args);
+    } else if (suite == "index") {
+        benchmarks::runLineIndexBenchmarks(args);
+    } else if (suite == "regress") {
+        benchmarks::runRegressionBenchmarks(args);
+    } else {
+        cerr << "Unknown suite: " << suite << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+# Profile-guided optimization.
+#
+#   PGO=GENERATE  instrumented build; `cmake --build <dir> --target pgo-train`
+#                 runs the bench suites on their generated inputs and leaves
+#                 the profiles in PGO_PROFILE_DIR
+#   PGO=USE       rebuilds with those profiles
+#
+# GCC finds .gcda files by object path, so GENERATE and USE must share one
+# build directory (the pgo-generate and pgo-use presets do).
+
+set(PGO OFF CACHE STRING "Profile-guided optimization: OFF, GENERATE or USE")
+set_property(CACHE PGO PROPERTY STRINGS OFF GENERATE USE)
+set(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH "Where PGO profiles are written and read")
+
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    find_program(LLVM_PROFDATA NAMES llvm-profdata)
+    if(NOT LLVM_PROFDATA AND APPLE)
+        set(LLVM_PROFDATA xcrun llvm-profdata)
+    endif()
+    set(_pgo_clang_raw "${PGO_PROFILE_DIR}/raw")
+    set(_pgo_clang_profile "${PGO_PROFILE_DIR}/merged.profdata")
+endif()
+
+if(PGO STREQUAL "GENERATE")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        # Atomic counters: the pool, logger and parallel sorter are threaded
+        add_compile_options(-fprofile-generate=${PGO_PROFILE_DIR} -fprofile-update=atomic)
+        add_link_options(-fprofile-generate=${PGO_PROFILE_DIR})
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        add_compile_options(-fprofile-instr-generate)
+        add_link_options(-fprofile-instr-generate)
+    else()
+        message(FATAL_ERROR "PGO is not supported for ${CMAKE_CXX_COMPILER_ID}")
+    endif()
+elseif(PGO STREQUAL "USE")
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        if(NOT EXISTS ${PGO_PROFILE_DIR})
+            message(WARNING "PGO=USE but ${PGO_PROFILE_DIR} does not exist; build with PGO=GENERATE and run pgo-train first")
+        endif()
+        add_compile_options(-fprofile-use=${PGO_PROFILE_DIR} -fprofile-partial-training -Wno-missing-profile)
+        add_link_options(-fprofile-use=${PGO_PROFILE_DIR})
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        if(NOT EXISTS ${_pgo_clang_profile})
+            message(FATAL_ERROR "PGO=USE but ${_pgo_clang_profile} does not exist; build with PGO=GENERATE and run pgo-train first")
+        endif()
+        add_compile_options(-fprofile-instr-use=${_pgo_clang_profile} -Wno-profile-instr-unprofiled)
+    else()
+        message(FATAL_ERROR "PGO is not supported for ${CMAKE_CXX_COMPILER_ID}")
+    endif()
+elseif(NOT PGO STREQUAL "OFF")
+    message(FATAL_ERROR "PGO must be OFF, GENERATE or USE (got '${PGO}')")
+endif()
+
+# Training run: every suite on moderate inputs, so the profile covers the
+# hot loops without taking minutes. Exists only in GENERATE builds.
+function(pgo_add_training_target bench_target)
+    if(NOT PGO STREQUAL "GENERATE")
+        return()
+    endif()
+
+    set(_suites
+        "regress 4M --reps=3"
+        "linescan 16M"
+        "parallel 16M"
+        "filenames 200000"
+        "sanitize 200000"
+        "format 200000"
+        "logger 2 50000"
+        "checked 1000000"
+        "reduce 4000000"
+        "alloc 200000"
+        "sharedstring 200000 2"
+        "span 4096"
+        "sort 1M"
+        "ingest 5000"
+        "scan 16M"
+        "cache 20000 500000"
+        "async 1000"
+        "index 16M 20000")
+
+    set(_commands COMMAND ${CMAKE_COMMAND} -E rm -rf ${PGO_PROFILE_DIR}
+                  COMMAND ${CMAKE_COMMAND} -E make_directory ${PGO_PROFILE_DIR})
+    foreach(_suite IN LISTS _suites)
+        separate_arguments(_args UNIX_COMMAND "${_suite}")
+        list(APPEND _commands COMMAND ${CMAKE_COMMAND} -E env LLVM_PROFILE_FILE=${_pgo_clang_raw}/bench-%p.profraw
+                                      $<TARGET_FILE:${bench_target}> ${_args})
+    endforeach()
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        list(APPEND _commands COMMAND ${LLVM_PROFDATA} merge -output=${_pgo_clang_profile} ${_pgo_clang_raw})
+    endif()
+
+    add_custom_target(pgo-train ${_commands}
+        DEPENDS ${bench_target}
+        WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+        COMMENT "Training PGO profiles with the bench suites"
+        VERBATIM)
+endfunction()
@@ -1,14 +1,39 @@
 #include <iostream>
 #include <limits>
-#include "overandunderflow/Underflow.cpp"
-#include "overandunderflow/Overflow.cpp"
+#include "overandunderflow/underflow.cpp"
+#include "overandunderflow/overflow.cpp"
 #include "Files/FileReader.h"
-#include "pointers/pointers.h"
+#include "Files/ParallelFileReader.h"
+#include "Pointers/pointers.h"
 #include "Format/FormatSecurity.h"
+#include "Logging/Trace.h"
 
 using namespace std;
 
+#ifdef LOGGING_TRACE
+#include <cstdlib>
+#include <new>
+
+// Counts every heap allocation for the trace's "allocations" counter
+void* operator new(size_t size) {
+    TRACE_COUNT(Allocations, 1);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+#endif
+
 int main() {
+#ifdef LOGGING_TRACE
+    logging::trace::start();
+#endif
 
     format_security::FormatDemo::runAllDemos();
 
@@ -29,9 +54,24 @@ int main() {
     cout << "\nReading using modern style:\n";
     reader.readFileModernStyle();
 
-    ptrdemo::runAllSafe(); // Run safe pointer demos
+    cout << "\nReading asynchronously:\n";
+    reader.readFileAsync();
+
+    cout << "\nReading in parallel (ordered):\n";
+    ParallelFileReader parallelReader(filename);
+    parallelReader.mapLines(
+        [](size_t, string_view line) { return string(line); },
+        [](size_t lineNumber, string&& line) { cout << lineNumber << ": " << line << '\n'; },
+        ParallelFileReader::Ordering::Ordered);
 
+    ptrdemo::runAllSafe(); // Run safe pointer demos
 
+#ifdef LOGGING_TRACE
+    // Open trace.json in chrome://tracing or ui.perfetto.dev
+    logging::trace::stop();
+    logging::trace::report(cerr);
+    if (!logging::trace::writeChromeTrace("trace.json")) cerr << "Failed to write trace.json\n";
+#endif
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,289 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Production version of what Overflow/Underflow demonstrate: integer types
+// whose +, -, * and / detect overflow with __builtin_*_overflow and react
+// according to a policy. Header-only so everything inlines into hot loops.
+//
+//   safe_math::checked<int> a = INT_MAX;     a + 1 throws std::overflow_error
+//   safe_math::saturating<int> b = INT_MAX;  b + 1 == INT_MAX
+//   safe_math::wrapping<int> c = INT_MAX;    c + 1 == INT_MIN (defined, no UB)
+//   safe_math::flagged<int> d = INT_MAX;     (d + 1).overflowed() == true
+//
+// Division by zero is not an overflow and throws std::domain_error under
+// every policy.
+namespace safe_math {
+
+enum class Direction { Up, Down };  // Past max / past min
+
+struct ThrowPolicy {
+    struct State {};
+    template <typename T>
+    static constexpr T onOverflow(T, Direction direction, State&) {
+        throw std::overflow_error(direction == Direction::Up ? "integer overflow" : "integer underflow");
+    }
+};
+
+struct SaturatePolicy {
+    struct State {};
+    template <typename T>
+    static constexpr T onOverflow(T, Direction direction, State&) {
+        return direction == Direction::Up ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+    }
+};
+
+struct WrapPolicy {
+    struct State {};
+    template <typename T>
+    static constexpr T onOverflow(T wrapped, Direction, State&) { return wrapped; }
+};
+
+// Wraps like WrapPolicy but remembers that it happened; the flag is sticky
+// and propagates through later operations
+struct FlagPolicy {
+    struct State {
+        bool overflowed = false;
+    };
+    template <typename T>
+    static constexpr T onOverflow(T wrapped, Direction, State& state) {
+        state.overflowed = true;
+        return wrapped;
+    }
+};
+
+template <std::integral T, typename Policy>
+class Checked {
+public:
+    using value_type = T;
+
+    constexpr Checked() = default;
+    constexpr Checked(T value) : value_(value) {}
+
+    constexpr T value() const { return value_; }
+    constexpr explicit operator T() const { return value_; }
+
+    // Only meaningful for FlagPolicy
+    constexpr bool overflowed() const {
+        if constexpr (std::is_same_v<Policy, FlagPolicy>) return state_.overflowed;
+        else return false;
+    }
+
+    friend constexpr Checked operator+(Checked a, Checked b) {
+        T result;
+        Checked out(a, b);
+        if (__builtin_add_overflow(a.value_, b.value_, &result)) {
+            result = Policy::onOverflow(result, addDirection(b.value_), out.state_);
+        }
+        out.value_ = result;
+        return out;
+    }
+
+    friend constexpr Checked operator-(Checked a, Checked b) {
+        T result;
+        Checked out(a, b);
+        if (__builtin_sub_overflow(a.value_, b.value_, &result)) {
+            result = Policy::onOverflow(result, subDirection(b.value_), out.state_);
+        }
+        out.value_ = result;
+        return out;
+    }
+
+    friend constexpr Checked operator*(Checked a, Checked b) {
+        T result;
+        Checked out(a, b);
+        if (__builtin_mul_overflow(a.value_, b.value_, &result)) {
+            bool negative = std::is_signed_v<T> && ((a.value_ < 0) != (b.value_ < 0));
+            result = Policy::onOverflow(result, negative ? Direction::Down : Direction::Up, out.state_);
+        }
+        out.value_ = result;
+        return out;
+    }
+
+    friend constexpr Checked operator/(Checked a, Checked b) {
+        if (b.value_ == 0) throw std::domain_error("division by zero");
+        Checked out(a, b);
+        if constexpr (std::is_signed_v<T>) {
+            // MIN / -1 is the only overflowing quotient
+            if (a.value_ == std::numeric_limits<T>::min() && b.value_ == -1) {
+                out.value_ = Policy::onOverflow(a.value_, Direction::Up, out.state_);
+                return out;
+            }
+        }
+        out.value_ = static_cast<T>(a.value_ / b.value_);
+        return out;
+    }
+
+    constexpr Checked operator-() const { return Checked(T{0}) - *this; }
+
+    constexpr Checked& operator+=(Checked other) { return *this = *this + other; }
+    constexpr Checked& operator-=(Checked other) { return *this = *this - other; }
+    constexpr Checked& operator*=(Checked other) { return *this = *this * other; }
+    constexpr Checked& operator/=(Checked other) { return *this = *this / other; }
+    constexpr Checked& operator++() { return *this += T{1}; }
+    constexpr Checked& operator--() { return *this -= T{1}; }
+
+    friend constexpr bool operator==(Checked a, Checked b) { return a.value_ == b.value_; }
+    friend constexpr auto operator<=>(Checked a, Checked b) { return a.value_ <=> b.value_; }
+
+private:
+    // Result of a binary op inherits both operands' state (sticky flag)
+    constexpr Checked(Checked a, Checked b) {
+        if constexpr (std::is_same_v<Policy, FlagPolicy>) {
+            state_.overflowed = a.state_.overflowed || b.state_.overflowed;
+        }
+    }
+
+    static constexpr Direction addDirection(T b) {
+        if constexpr (std::is_signed_v<T>) return b < 0 ? Direction::Down : Direction::Up;
+        else return Direction::Up;
+    }
+
+    static constexpr Direction subDirection(T b) {
+        if constexpr (std::is_signed_v<T>) return b < 0 ? Direction::Up : Direction::Down;
+        else return Direction::Down;
+    }
+
+    T value_{};
+    [[no_unique_address]] typename Policy::State state_{};
+};
+
+template <std::integral T> using checked = Checked<T, ThrowPolicy>;
+template <std::integral T> using saturating = Checked<T, SaturatePolicy>;
+template <std::integral T> using wrapping = Checked<T, WrapPolicy>;
+template <std::integral T> using flagged = Checked<T, FlagPolicy>;
+
+// ---------------------------------------------------------------------------
+// Batch element-wise operations over spans. The loops are branch-free (the
+// overflow test is bit arithmetic on the wrapped result), so the compiler
+// vectorizes them; the policy only selects what lands in `out`:
+//   SaturatePolicy: clamped value, WrapPolicy/FlagPolicy: wrapped value,
+//   ThrowPolicy: wrapped value, then throws if any lane overflowed.
+// out may alias a or b. Sizes must match (the shortest length is used).
+
+struct BatchResult {
+    size_t overflows = 0;   // Lanes that overflowed
+    size_t firstIndex = 0;  // First overflowing lane (valid when overflows > 0)
+};
+
+namespace detail {
+
+// Clamp value for an overflowing add/sub lane, derived without branching:
+// signed add overflows toward b's sign, sub toward the opposite sign
+template <typename T>
+constexpr T saturationFor(T b, bool add) {
+    using U = std::make_unsigned_t<T>;
+    if constexpr (std::is_signed_v<T>) {
+        T toward = add ? b : static_cast<T>(~b);
+        return static_cast<T>(static_cast<U>(std::numeric_limits<T>::max()) + (static_cast<U>(toward) >> (sizeof(T) * 8 - 1)));
+    } else {
+        (void)b;
+        return add ? std::numeric_limits<T>::max() : T{0};
+    }
+}
+
+template <typename T, bool Add>
+struct AddSubLane {
+    static constexpr T apply(T a, T b, bool& overflow) {
+        using U = std::make_unsigned_t<T>;
+        T s = static_cast<T>(Add ? static_cast<U>(static_cast<U>(a) + static_cast<U>(b))
+                                 : static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+        if constexpr (std::is_signed_v<T>) {
+            overflow = Add ? ((a ^ s) & (b ^ s)) < 0 : ((a ^ b) & (a ^ s)) < 0;
+        } else {
+            overflow = Add ? s < a : a < b;
+        }
+        return s;
+    }
+};
+
+template <typename T>
+struct MulLane {
+    static constexpr T apply(T a, T b, bool& overflow, T& saturated) {
+        if constexpr (sizeof(T) <= 4) {
+            // Widen: the exact product fits in 64 bits
+            using W = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+            W p = static_cast<W>(a) * static_cast<W>(b);
+            overflow = p > static_cast<W>(std::numeric_limits<T>::max()) ||
+                       p < static_cast<W>(std::numeric_limits<T>::min());
+            saturated = p > 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+            return static_cast<T>(p);
+        } else {
+            T p;
+            overflow = __builtin_mul_overflow(a, b, &p);
+            bool negative = std::is_signed_v<T> && ((a < 0) != (b < 0));
+            saturated = negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+            return p;
+        }
+    }
+};
+
+template <typename Policy, typename T, typename Lane>
+BatchResult runBatch(std::span<const T> a, std::span<const T> b, std::span<T> out, Lane lane) {
+    size_t n = a.size();
+    if (b.size() < n) n = b.size();
+    if (out.size() < n) n = out.size();
+
+    size_t overflows = 0;
+    for (size_t i = 0; i < n; ++i) {
+        bool overflow;
+        T saturated;
+        T wrapped = lane(a[i], b[i], overflow, saturated);
+        if constexpr (std::is_same_v<Policy, SaturatePolicy>) {
+            out[i] = overflow ? saturated : wrapped;
+        } else {
+            out[i] = wrapped;
+        }
+        overflows += overflow;
+    }
+
+    BatchResult result{overflows, 0};
+    if (overflows > 0) {
+        // Rare path: rescan for the first offending lane
+        for (size_t i = 0; i < n; ++i) {
+            bool overflow;
+            T saturated;
+            lane(a[i], b[i], overflow, saturated);
+            if (overflow) {
+                result.firstIndex = i;
+                break;
+            }
+        }
+        if constexpr (std::is_same_v<Policy, ThrowPolicy>) {
+            throw std::overflow_error("integer overflow at index " + std::to_string(result.firstIndex));
+        }
+    }
+    return result;
+}
+
+} // namespace detail
+
+template <typename Policy = SaturatePolicy, std::integral T>
+BatchResult add(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    return detail::runBatch<Policy, T>(a, b, out, [](T x, T y, bool& overflow, T& saturated) {
+        saturated = detail::saturationFor(y, true);
+        return detail::AddSubLane<T, true>::apply(x, y, overflow);
+    });
+}
+
+template <typename Policy = SaturatePolicy, std::integral T>
+BatchResult sub(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    return detail::runBatch<Policy, T>(a, b, out, [](T x, T y, bool& overflow, T& saturated) {
+        saturated = detail::saturationFor(y, false);
+        return detail::AddSubLane<T, false>::apply(x, y, overflow);
+    });
+}
+
+template <typename Policy = SaturatePolicy, std::integral T>
+BatchResult mul(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    return detail::runBatch<Policy, T>(a, b, out, [](T x, T y, bool& overflow, T& saturated) {
+        return detail::MulLane<T>::apply(x, y, overflow, saturated);
+    });
+}
+
+} // namespace safe_math
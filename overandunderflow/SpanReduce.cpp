@@ -0,0 +1,237 @@
+#include "SpanReduce.h"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SPANREDUCE_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SPANREDUCE_NEON 1
+#endif
+
+namespace safe_math {
+
+namespace {
+
+constexpr size_t kBlock = 4096;
+
+struct BlockSummary {
+    long long sum;
+    unsigned long long absSum;
+    int min;
+    int max;
+};
+
+using BlockFn = BlockSummary (*)(const int* p, size_t n);
+
+BlockSummary blockScalar(const int* p, size_t n) {
+    BlockSummary s{0, 0, INT_MAX, INT_MIN};
+    for (size_t i = 0; i < n; ++i) {
+        long long v = p[i];
+        s.sum += v;
+        s.absSum += static_cast<unsigned long long>(v < 0 ? -v : v);
+        s.min = p[i] < s.min ? p[i] : s.min;
+        s.max = p[i] > s.max ? p[i] : s.max;
+    }
+    return s;
+}
+
+#ifdef SPANREDUCE_X86
+
+__attribute__((target("sse4.1")))
+BlockSummary blockSSE41(const int* p, size_t n) {
+    __m128i sum = _mm_setzero_si128(), absSum = _mm_setzero_si128();
+    __m128i mn = _mm_set1_epi32(INT_MAX), mx = _mm_set1_epi32(INT_MIN);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        // abs(INT_MIN) stays 0x80000000, which is exact read as unsigned
+        __m128i a = _mm_abs_epi32(v);
+        sum = _mm_add_epi64(sum, _mm_add_epi64(_mm_cvtepi32_epi64(v), _mm_cvtepi32_epi64(_mm_srli_si128(v, 8))));
+        absSum = _mm_add_epi64(absSum, _mm_add_epi64(_mm_cvtepu32_epi64(a), _mm_cvtepu32_epi64(_mm_srli_si128(a, 8))));
+        mn = _mm_min_epi32(mn, v);
+        mx = _mm_max_epi32(mx, v);
+    }
+    alignas(16) long long sums[2];
+    alignas(16) unsigned long long abss[2];
+    alignas(16) int mins[4], maxs[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(sums), sum);
+    _mm_store_si128(reinterpret_cast<__m128i*>(abss), absSum);
+    _mm_store_si128(reinterpret_cast<__m128i*>(mins), mn);
+    _mm_store_si128(reinterpret_cast<__m128i*>(maxs), mx);
+
+    BlockSummary s = blockScalar(p + i, n - i);
+    s.sum += sums[0] + sums[1];
+    s.absSum += abss[0] + abss[1];
+    for (int k = 0; k < 4; ++k) {
+        s.min = mins[k] < s.min ? mins[k] : s.min;
+        s.max = maxs[k] > s.max ? maxs[k] : s.max;
+    }
+    return s;
+}
+
+__attribute__((target("avx2")))
+BlockSummary blockAVX2(const int* p, size_t n) {
+    __m256i sum = _mm256_setzero_si256(), absSum = _mm256_setzero_si256();
+    __m256i mn = _mm256_set1_epi32(INT_MAX), mx = _mm256_set1_epi32(INT_MIN);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i a = _mm256_abs_epi32(v);
+        __m128i lo = _mm256_castsi256_si128(v), hi = _mm256_extracti128_si256(v, 1);
+        __m128i alo = _mm256_castsi256_si128(a), ahi = _mm256_extracti128_si256(a, 1);
+        sum = _mm256_add_epi64(sum, _mm256_add_epi64(_mm256_cvtepi32_epi64(lo), _mm256_cvtepi32_epi64(hi)));
+        absSum = _mm256_add_epi64(absSum, _mm256_add_epi64(_mm256_cvtepu32_epi64(alo), _mm256_cvtepu32_epi64(ahi)));
+        mn = _mm256_min_epi32(mn, v);
+        mx = _mm256_max_epi32(mx, v);
+    }
+    alignas(32) long long sums[4];
+    alignas(32) unsigned long long abss[4];
+    alignas(32) int mins[8], maxs[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(sums), sum);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(abss), absSum);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(mins), mn);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), mx);
+
+    BlockSummary s = blockScalar(p + i, n - i);
+    for (int k = 0; k < 4; ++k) {
+        s.sum += sums[k];
+        s.absSum += abss[k];
+    }
+    for (int k = 0; k < 8; ++k) {
+        s.min = mins[k] < s.min ? mins[k] : s.min;
+        s.max = maxs[k] > s.max ? maxs[k] : s.max;
+    }
+    return s;
+}
+
+#endif // SPANREDUCE_X86
+
+#ifdef SPANREDUCE_NEON
+
+BlockSummary blockNEON(const int* p, size_t n) {
+    int64x2_t sum = vdupq_n_s64(0);
+    uint64x2_t absSum = vdupq_n_u64(0);
+    int32x4_t mn = vdupq_n_s32(INT_MAX), mx = vdupq_n_s32(INT_MIN);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t v = vld1q_s32(p + i);
+        sum = vpadalq_s32(sum, v);
+        absSum = vpadalq_u32(absSum, vreinterpretq_u32_s32(vabsq_s32(v)));
+        mn = vminq_s32(mn, v);
+        mx = vmaxq_s32(mx, v);
+    }
+    BlockSummary s = blockScalar(p + i, n - i);
+    s.sum += vaddvq_s64(sum);
+    s.absSum += vaddvq_u64(absSum);
+    int vmin = vminvq_s32(mn), vmax = vmaxvq_s32(mx);
+    s.min = vmin < s.min ? vmin : s.min;
+    s.max = vmax > s.max ? vmax : s.max;
+    return s;
+}
+
+#endif // SPANREDUCE_NEON
+
+struct Kernel {
+    ReduceIsa isa;
+    BlockFn block;
+};
+
+const Kernel* kernelFor(ReduceIsa isa) {
+    static const Kernel scalar{ReduceIsa::Scalar, blockScalar};
+    switch (isa) {
+        case ReduceIsa::Scalar: return &scalar;
+#ifdef SPANREDUCE_X86
+        case ReduceIsa::SSE41: {
+            static const Kernel k{ReduceIsa::SSE41, blockSSE41};
+            return __builtin_cpu_supports("sse4.1") ? &k : nullptr;
+        }
+        case ReduceIsa::AVX2: {
+            static const Kernel k{ReduceIsa::AVX2, blockAVX2};
+            return __builtin_cpu_supports("avx2") ? &k : nullptr;
+        }
+#endif
+#ifdef SPANREDUCE_NEON
+        case ReduceIsa::NEON: {
+            static const Kernel k{ReduceIsa::NEON, blockNEON};
+            return &k;
+        }
+#endif
+        default: return nullptr;
+    }
+}
+
+std::atomic<const Kernel*>& activeKernel() {
+    static std::atomic<const Kernel*> active{[] {
+        for (auto isa : {ReduceIsa::AVX2, ReduceIsa::SSE41, ReduceIsa::NEON}) {
+            if (const Kernel* k = kernelFor(isa)) return k;
+        }
+        return kernelFor(ReduceIsa::Scalar);
+    }()};
+    return active;
+}
+
+} // namespace
+
+ReduceResult reduce(std::span<const int> values) {
+    BlockFn block = activeKernel().load(std::memory_order_relaxed)->block;
+    ReduceResult result;
+    result.firstIndex = values.size();
+    bool found = false;
+
+    for (size_t start = 0; start < values.size(); start += kBlock) {
+        size_t n = values.size() - start < kBlock ? values.size() - start : kBlock;
+        const int* p = values.data() + start;
+        BlockSummary s = block(p, n);
+
+        // Every prefix inside the block lies within running +- absSum
+        // (running itself is in range until the first overflow is found)
+        long long running = result.sum;
+        auto reach = static_cast<long long>(s.absSum);
+        bool mayLeave = running + reach > INT_MAX || running - reach < INT_MIN;
+        if (!found && mayLeave) {
+            // Exact rescan: running int sum as the plain loop would see it
+            long long prefix = running;
+            for (size_t i = 0; i < n; ++i) {
+                prefix += p[i];
+                if (prefix > INT_MAX || prefix < INT_MIN) {
+                    result.overflow = prefix > INT_MAX;
+                    result.underflow = prefix < INT_MIN;
+                    result.firstIndex = start + i;
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        result.sum += s.sum;
+        result.min = s.min < result.min ? s.min : result.min;
+        result.max = s.max > result.max ? s.max : result.max;
+    }
+    return result;
+}
+
+ReduceIsa activeReduceIsa() {
+    return activeKernel().load(std::memory_order_relaxed)->isa;
+}
+
+bool forceReduceIsa(ReduceIsa isa) {
+    const Kernel* k = kernelFor(isa);
+    if (!k) return false;
+    activeKernel().store(k, std::memory_order_relaxed);
+    return true;
+}
+
+const char* reduceIsaName(ReduceIsa isa) {
+    switch (isa) {
+        case ReduceIsa::Scalar: return "scalar";
+        case ReduceIsa::SSE41: return "sse4.1";
+        case ReduceIsa::AVX2: return "avx2";
+        case ReduceIsa::NEON: return "neon";
+    }
+    return "unknown";
+}
+
+} // namespace safe_math
@@ -0,0 +1,38 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <span>
+
+// Sum / min / max over large int spans that also reports whether the running
+// int sum (what `int total = 0; for (v : values) total += v;` computes) ever
+// left the int range, and at which element - the overflow and underflow the
+// overandunderflow demos show, detected across millions of values.
+namespace safe_math {
+
+struct ReduceResult {
+    long long sum = 0;          // Exact total (64-bit, never wraps)
+    int min = INT_MAX;
+    int max = INT_MIN;
+    // The first time the running int sum left the int range: at most one
+    // flag is set, saying in which direction, and firstIndex is the element
+    // that took it out (== size when it never did). Later excursions are
+    // not reported, since past that point the int loop has already wrapped.
+    bool overflow = false;      // First left the range above INT_MAX
+    bool underflow = false;     // First left the range below INT_MIN
+    size_t firstIndex = 0;
+};
+
+enum class ReduceIsa { Scalar, SSE41, AVX2, NEON };
+
+// Works in blocks: a vector kernel yields each block's exact sum, |value|
+// sum, min and max. When the running sum plus the block's |value| sum
+// cannot leave the int range, no prefix inside the block can either;
+// only blocks that might overflow are rescanned exactly.
+ReduceResult reduce(std::span<const int> values);
+
+// Kernel selection (detected once at startup; force is for benchmarks)
+ReduceIsa activeReduceIsa();
+bool forceReduceIsa(ReduceIsa isa);
+const char* reduceIsaName(ReduceIsa isa);
+
+} // namespace safe_math
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <climits> // For INT_MAX
+#include "CheckedArithmetic.h"
 
 class Overflow {
 public:
@@ -9,5 +10,17 @@ public:
         std::cout << "Initial value: " << max << std::endl;
         max = max + 1; // Causes overflow
         std::cout << "After adding 1: " << max << std::endl;
+
+        // Checked alternatives
+        safe_math::saturating<int> saturated = INT_MAX;
+        std::cout << "saturating<int> + 1: " << (saturated + 1).value() << std::endl;
+        safe_math::flagged<int> flagged = INT_MAX;
+        std::cout << "flagged<int> + 1 overflowed: " << (flagged + 1).overflowed() << std::endl;
+        try {
+            safe_math::checked<int> checked = INT_MAX;
+            checked += 1;
+        } catch (const std::overflow_error& e) {
+            std::cout << "checked<int> + 1 threw: " << e.what() << std::endl;
+        }
     }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <limits>
+#include "CheckedArithmetic.h"
 
 
 class Underflow {
@@ -14,6 +15,11 @@ public:
         if (minInt == std::numeric_limits<int>::min()) {
             std::cout << "inside if condition" << std::endl;
             std::cout << "Underflow risk if subtracting 1!" << std::endl;
+
+            safe_math::saturating<int> saturated = minInt;
+            std::cout << "saturating<int> - 1: " << (saturated - 1).value() << std::endl;
+            safe_math::wrapping<int> wrapped = minInt;
+            std::cout << "wrapping<int> - 1 (defined): " << (wrapped - 1).value() << std::endl;
             return;
         }
 
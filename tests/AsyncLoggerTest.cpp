@@ -0,0 +1,87 @@
+#include "Check.h"
+#include "../Logging/AsyncLogger.h"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using logging::AsyncLogger;
+using logging::Layout;
+using logging::LoggerOptions;
+
+namespace {
+
+size_t countLines(FILE* file) {
+    std::rewind(file);
+    size_t lines = 0;
+    for (int c; (c = std::fgetc(file)) != EOF;) lines += (c == '\n');
+    return lines;
+}
+
+} // namespace
+
+// Rings of exited threads are drained, then freed; their records still
+// show in stats()
+void testExitedThreadsReleaseRings() {
+    FILE* sink = std::tmpfile();
+    LoggerOptions options;
+    options.sink = sink;
+    options.layout = Layout::Plain;
+    options.ringBytes = 4096;
+    constexpr size_t kWaves = 10, kThreads = 20, kRecords = 3;
+    {
+        AsyncLogger logger(options);
+        for (size_t wave = 0; wave < kWaves; ++wave) {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < kThreads; ++t) {
+                threads.emplace_back([&logger, wave, t] {
+                    for (size_t i = 0; i < kRecords; ++i) logger.info("wave {} thread {} record {}", wave, t, i);
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+        }
+        logger.flush();
+        AsyncLogger::Stats stats = logger.stats();
+        CHECK(stats.rings == 0);
+        CHECK(stats.records == kWaves * kThreads * kRecords);
+
+        // A live thread keeps its ring
+        logger.info("from the test thread");
+        logger.flush();
+        CHECK(logger.stats().rings == 1);
+    }
+    CHECK(countLines(sink) == kWaves * kThreads * kRecords + 1);
+    std::fclose(sink);
+}
+
+// A thread that outlives its logger must not touch the freed logger or
+// ring when it exits
+void testThreadOutlivesLogger() {
+    FILE* sink = std::tmpfile();
+    LoggerOptions options;
+    options.sink = sink;
+    options.layout = Layout::Plain;
+    std::atomic<int> step{0};
+    std::thread worker;
+    {
+        AsyncLogger logger(options);
+        worker = std::thread([&] {
+            logger.info("before the logger goes away");
+            step = 1;
+            while (step != 2) std::this_thread::yield();
+        });
+        while (step != 1) std::this_thread::yield();
+    }
+    step = 2;
+    worker.join();
+    CHECK(countLines(sink) == 1);
+    std::fclose(sink);
+}
+
+int main() {
+    testExitedThreadsReleaseRings();
+    testThreadOutlivesLogger();
+    return testFailures() ? 1 : 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdio>
+
+// Minimal checks for the unit tests: unlike assert they stay active in
+// Release builds. Each test executable returns testFailures() from main,
+// so ctest reports any failed CHECK.
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++testFailures();                                                         \
+        }                                                                             \
+    } while (0)
@@ -0,0 +1,149 @@
+// Exercise the bounds checks in Release builds too
+#define PTRDEMO_BOUNDS_CHECK 1
+
+#include "Check.h"
+#include "../Pointers/checked_span.h"
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using ptrdemo::CheckedSpan;
+using ptrdemo::SmallVector;
+
+// Heap blocks currently allocated, to catch leaked buffers without ASan
+static long gLiveAllocations = 0;
+
+void* operator new(size_t size) {
+    ++gLiveAllocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    if (p) --gLiveAllocations;
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+// Copy-assigning one heap-backed vector over another must free the old buffer
+void testCopyAssignHeapOverHeap() {
+    long before = gLiveAllocations;
+    {
+        SmallVector<int, 4> a, b;
+        for (int i = 0; i < 100; ++i) {
+            a.push_back(i);
+            b.push_back(1000 + i);
+        }
+        CHECK(!a.isInline() && !b.isInline());
+        a = b;
+        CHECK(a.size() == 100);
+        CHECK(a[0] == 1000 && a[99] == 1099);
+        CHECK(b.size() == 100);
+    }
+    CHECK(gLiveAllocations == before);
+}
+
+// Heap over inline, inline over heap, and non-trivial elements
+void testCopyAssignMixed() {
+    long before = gLiveAllocations;
+    {
+        SmallVector<std::string, 2> small{"a"}, large;
+        for (int i = 0; i < 50; ++i) {
+            const std::string value(40, static_cast<char>('a' + i % 26));
+            large.push_back(value);
+        }
+        SmallVector<std::string, 2> target = small;
+        target = large;
+        CHECK(target.size() == 50 && target[49] == large[49]);
+        target = small;
+        CHECK(target.size() == 1 && target[0] == "a");
+        CHECK(target.isInline());
+        target = target;
+        CHECK(target.size() == 1 && target[0] == "a");
+    }
+    CHECK(gLiveAllocations == before);
+}
+
+void testMoveAssign() {
+    long before = gLiveAllocations;
+    {
+        SmallVector<int, 4> a, b;
+        for (int i = 0; i < 100; ++i) a.push_back(i);
+        for (int i = 0; i < 50; ++i) b.push_back(i);
+        a = std::move(b);
+        CHECK(a.size() == 50 && a[49] == 49);
+    }
+    CHECK(gLiveAllocations == before);
+}
+
+// Appending one of the vector's own elements while it grows: the argument
+// must be read before the old buffer is moved out and freed
+void testPushBackOwnElementWhileGrowing() {
+    long before = gLiveAllocations;
+    {
+        SmallVector<std::string, 2> v{std::string(40, 'a'), std::string(40, 'b')};
+        v.push_back(v[0]);  // First spill from inline storage
+        CHECK(!v.isInline());
+        CHECK(v.size() == 3 && v[2] == std::string(40, 'a') && v[0] == v[2]);
+        const std::string filler(40, 'c');
+        while (v.size() < v.capacity()) v.push_back(filler);
+        v.push_back(v[1]);  // Heap to bigger heap
+        CHECK(v[v.size() - 1] == std::string(40, 'b'));
+        v.emplace_back(v[0]);
+        CHECK(v[v.size() - 1] == std::string(40, 'a'));
+
+        SmallVector<int, 1> ints{7};
+        for (int i = 0; i < 10; ++i) ints.push_back(ints[0]);
+        CHECK(ints.size() == 11 && ints[10] == 7);
+    }
+    CHECK(gLiveAllocations == before);
+}
+
+// Runs f in a child process; true if it aborted
+template <typename F>
+bool aborts([[maybe_unused]] F&& f) {
+#if defined(__unix__) || defined(__APPLE__)
+    pid_t child = fork();
+    if (child == 0) {
+        std::freopen("/dev/null", "w", stderr);
+        f();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+#else
+    return true;
+#endif
+}
+
+void testSubspanBounds() {
+    int values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    CheckedSpan<int> span(values);
+    CHECK(span.subspan(8, 0).empty());
+    CHECK(span.subspan(2, 6).size() == 6 && span.subspan(2, 6)[0] == 2);
+    CHECK(aborts([&] { span.subspan(3, 6); }));
+    CHECK(aborts([&] { span.subspan(9, 0); }));
+    // offset + count wraps to 7, which a sum-based check accepted
+    CHECK(aborts([&] { span.subspan(8, SIZE_MAX); }));
+}
+
+int main() {
+    testCopyAssignHeapOverHeap();
+    testCopyAssignMixed();
+    testMoveAssign();
+    testPushBackOwnElementWhileGrowing();
+    testSubspanBounds();
+    return testFailures() ? 1 : 0;
+}
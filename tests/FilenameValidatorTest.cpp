@@ -0,0 +1,85 @@
+#include "Check.h"
+#include "../Format/FilenameValidator.h"
+
+#include <string>
+#include <vector>
+
+using format_security::FilenameBatch;
+using format_security::FilenameValidator;
+using format_security::FilenameVerdict;
+
+namespace {
+
+// Every byte value alone, inside a name, and at each position of a 64-byte
+// block, so each byte passes through every SIMD lane
+FilenameBatch everyByte() {
+    FilenameBatch batch;
+    for (unsigned b = 0; b < 256; ++b) {
+        char c = static_cast<char>(b);
+        batch.add(std::string(1, c));
+        batch.add("name" + std::string(1, c) + ".txt");
+        for (size_t lane = 0; lane < 64; ++lane) {
+            std::string block(64, 'x');
+            block[lane] = c;
+            batch.add(block);
+        }
+    }
+    std::string all;
+    for (unsigned b = 0; b < 256; ++b) all += static_cast<char>(b);
+    batch.add(all);
+    batch.add("a..b");
+    batch.add(".");
+    batch.add(".");  // ".." split across two names is not a traversal
+    batch.add(std::string(300, 'y'));
+    batch.add("");
+    return batch;
+}
+
+std::vector<FilenameVerdict> validateWith(FilenameValidator::Isa isa, const FilenameBatch& batch) {
+    FilenameValidator::forceIsa(isa);
+    return FilenameValidator::validate(batch);
+}
+
+} // namespace
+
+void testKernelsMatchScalar() {
+    const FilenameValidator::Isa detected = FilenameValidator::activeIsa();
+    const FilenameBatch batch = everyByte();
+    const std::vector<FilenameVerdict> expected = validateWith(FilenameValidator::Isa::Scalar, batch);
+
+    for (auto isa : {FilenameValidator::Isa::SSE2, FilenameValidator::Isa::AVX2, FilenameValidator::Isa::NEON}) {
+        if (!FilenameValidator::isaSupported(isa)) {
+            std::printf("%s: not supported, skipped\n", FilenameValidator::isaName(isa));
+            continue;
+        }
+        std::vector<FilenameVerdict> verdicts = validateWith(isa, batch);
+        CHECK(verdicts.size() == expected.size());
+        for (size_t i = 0; i < verdicts.size() && i < expected.size(); ++i) {
+            if (verdicts[i] != expected[i]) {
+                std::fprintf(stderr, "%s: name %zu is %s, scalar says %s\n", FilenameValidator::isaName(isa), i,
+                             FilenameValidator::describe(verdicts[i]), FilenameValidator::describe(expected[i]));
+                CHECK(verdicts[i] == expected[i]);
+                break;
+            }
+        }
+    }
+    FilenameValidator::forceIsa(detected);
+}
+
+// The scalar kernel applies isValidFilename's byte rules
+void testScalarVerdicts() {
+    FilenameBatch batch;
+    for (const char* name : {"ok.txt", "tab\there", "new\nline", "100%", "a..b"}) batch.add(name);
+    std::vector<FilenameVerdict> verdicts = validateWith(FilenameValidator::Isa::Scalar, batch);
+    CHECK(verdicts[0] == FilenameVerdict::Valid);
+    CHECK(verdicts[1] == FilenameVerdict::Valid);
+    CHECK(verdicts[2] == FilenameVerdict::ControlCharacter);
+    CHECK(verdicts[3] == FilenameVerdict::FormatSpecifier);
+    CHECK(verdicts[4] == FilenameVerdict::PathTraversal);
+}
+
+int main() {
+    testKernelsMatchScalar();
+    testScalarVerdicts();
+    return testFailures() ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+#include "Check.h"
+#include "../Files/FileReader.h"
+#include "../Files/LineIndex.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const fs::path kDir = fs::temp_directory_path() / "line_index_test";
+
+void writeFile(const std::string& path, const std::string& text, bool append = false) {
+    std::ofstream out(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    out << text;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+std::vector<std::string> getlineLines(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    return lines;
+}
+
+std::string numberedLines(size_t from, size_t count) {
+    std::string text;
+    for (size_t i = from; i < from + count; ++i) text += "line " + std::to_string(i) + std::string(i % 17, 'x') + '\n';
+    return text;
+}
+
+// Every line, and a few ranges, against getline
+bool matchesGetline(const std::string& path) {
+    LineIndex index(path);
+    auto expected = getlineLines(path);
+    if (!index.upToDate() || index.lineCount() != expected.size()) return false;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (index.line(i) != expected[i]) return false;
+    }
+    for (size_t first : {size_t{0}, expected.size() / 2, expected.size() - 1}) {
+        std::string joined;
+        for (size_t i = first; i < std::min(expected.size(), first + 5); ++i) {
+            joined += (i > first ? "\n" : "") + expected[i];
+        }
+        if (index.lines(first, 5) != joined) return false;
+    }
+    return true;
+}
+
+size_t strayTemporaries() {
+    size_t stray = 0;
+    for (const auto& entry : fs::directory_iterator(kDir)) {
+        std::string name = entry.path().filename().string();
+        stray += name.find(".lidx.") != std::string::npos;
+    }
+    return stray;
+}
+
+} // namespace
+
+void testFullThenIncrementalBuild() {
+    std::string path = (kDir / "append.log").string();
+    writeFile(path, numberedLines(0, 1000));
+    LineIndex::BuildStats stats;
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(!stats.incremental && stats.lines == 1000);
+    CHECK(matchesGetline(path));
+
+    std::string appended = numberedLines(1000, 300);
+    writeFile(path, appended, true);
+    CHECK(!LineIndex(path).upToDate());
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(stats.incremental && stats.lines == 1300);
+    CHECK(stats.scannedBytes == appended.size());
+    CHECK(matchesGetline(path));
+
+    // Nothing new: reused as is
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(stats.incremental && stats.scannedBytes == 0);
+}
+
+// A last line without '\n' may still grow: it is rescanned, not kept
+void testOpenTail() {
+    std::string path = (kDir / "open_tail.log").string();
+    writeFile(path, numberedLines(0, 200) + "partial");
+    LineIndex::BuildStats stats;
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(stats.lines == 201);
+    CHECK(LineIndex(path).line(200) == "partial");
+
+    writeFile(path, " line done\nnext\nlast without newline", true);
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(stats.incremental && stats.lines == 203);
+    CHECK(stats.scannedBytes == std::string("partial line done\nnext\nlast without newline").size());
+    CHECK(LineIndex(path).line(200) == "partial line done");
+    CHECK(matchesGetline(path));
+}
+
+// A rewritten source or a damaged sidecar is never reused
+void testRewriteAndCorruption() {
+    std::string path = (kDir / "corrupt.log").string();
+    std::string sidecar = LineIndex::sidecarPath(path);
+    writeFile(path, numberedLines(0, 500));
+    CHECK(LineIndex::build(path));
+
+    writeFile(path, numberedLines(10000, 600));  // Longer, different head
+    CHECK(!LineIndex(path).valid());
+    LineIndex::BuildStats stats;
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(!stats.incremental);
+    CHECK(matchesGetline(path));
+
+    // Flip a byte in the length column (the end of the sidecar): the header
+    // still parses, so only the column checksum catches it
+    std::string index = readFile(sidecar);
+    index[index.size() - 3] ^= 0x40;
+    writeFile(sidecar, index);
+    writeFile(path, numberedLines(10600, 10), true);
+    CHECK(LineIndex::build(path, &stats));
+    CHECK(!stats.incremental);
+    CHECK(matchesGetline(path));
+
+    // A truncated sidecar is invalid, not read past its end
+    index = readFile(sidecar);
+    writeFile(sidecar, index.substr(0, index.size() / 2));
+    CHECK(!LineIndex(path).valid());
+    CHECK(LineIndex::build(path, &stats) && !stats.incremental);
+    CHECK(matchesGetline(path));
+}
+
+// Concurrent builders each write their own temporary, and the sidecar
+// left behind is always complete
+void testConcurrentBuilds() {
+    std::string path = (kDir / "concurrent.log").string();
+    writeFile(path, numberedLines(0, 20000));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 5; ++i) {
+                fs::remove(LineIndex::sidecarPath(path));
+                LineIndex::build(path);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    CHECK(LineIndex::build(path));
+    CHECK(matchesGetline(path));
+    CHECK(strayTemporaries() == 0);
+}
+
+// forEachLineInRange only writes a sidecar when asked to
+void testRangeReadsBuildOnlyOnRequest() {
+    std::string path = (kDir / "range.log").string();
+    std::string sidecar = LineIndex::sidecarPath(path);
+    writeFile(path, numberedLines(0, 100));
+    auto expected = getlineLines(path);
+
+    std::vector<std::string> lines;
+    auto collect = [&](std::string_view line) { lines.emplace_back(line); };
+    CHECK(FileReader(path).forEachLineInRange(10, 3, collect));
+    CHECK(!fs::exists(sidecar));
+    CHECK(lines == std::vector<std::string>(expected.begin() + 10, expected.begin() + 13));
+
+    lines.clear();
+    CHECK(FileReader(path).forEachLineInRange(98, 10, collect, true));
+    CHECK(fs::exists(sidecar));
+    CHECK(lines == std::vector<std::string>(expected.begin() + 98, expected.end()));
+}
+
+int main() {
+    fs::remove_all(kDir);
+    fs::create_directories(kDir);
+    testFullThenIncrementalBuild();
+    testOpenTail();
+    testRewriteAndCorruption();
+    testConcurrentBuilds();
+    testRangeReadsBuildOnlyOnRequest();
+    fs::remove_all(kDir);
+    return testFailures() ? 1 : 0;
+}
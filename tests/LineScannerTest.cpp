@@ -0,0 +1,96 @@
+#include "Check.h"
+#include "../Files/LineScanner.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const LineScanner::Isa kAllIsas[] = {
+    LineScanner::Isa::Scalar, LineScanner::Isa::SSE2, LineScanner::Isa::AVX2,
+    LineScanner::Isa::AVX512, LineScanner::Isa::NEON,
+};
+
+// Text with empty lines, CRLF endings and lines straddling vector blocks
+std::string makeText(size_t bytes, unsigned seed, int maxLine) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> lineLength(0, maxLine);
+    std::uniform_int_distribution<int> crlf(0, 3);
+    std::string text;
+    while (text.size() < bytes) {
+        text.append(static_cast<size_t>(lineLength(rng)), static_cast<char>('a' + text.size() % 26));
+        if (crlf(rng) == 0) text += '\r';
+        text += '\n';
+    }
+    if (seed % 2) text.resize(bytes);  // Odd seeds end without a terminator
+    return text;
+}
+
+std::vector<std::string> getlineLines(const std::string& text, bool stripCarriageReturn) {
+    std::vector<std::string> lines;
+    std::istringstream in(text);
+    for (std::string line; std::getline(in, line);) {
+        if (stripCarriageReturn && !line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::vector<std::string> scannerLines(const std::string& text, size_t batch, bool stripCarriageReturn) {
+    std::vector<std::string> lines;
+    std::vector<LineSpan> spans(batch);
+    LineScanner scanner(text, stripCarriageReturn);
+    while (size_t n = scanner.nextBatch(spans.data(), batch)) {
+        for (size_t i = 0; i < n; ++i) lines.emplace_back(scanner.line(spans[i]));
+    }
+    return lines;
+}
+
+} // namespace
+
+// Every kernel against getline, with and without CRLF stripping, for
+// several batch sizes and with and without a final terminator
+void testKernelsMatchGetline(LineScanner::Isa isa) {
+    for (unsigned seed = 0; seed < 40; ++seed) {
+        std::string text = makeText(1 + seed * 97, seed, seed % 3 == 0 ? 3 : 150);
+        for (bool strip : {false, true}) {
+            auto expected = getlineLines(text, strip);
+            for (size_t batch : {1u, 7u, 64u, 1000u}) {
+                if (scannerLines(text, batch, strip) != expected) {
+                    std::fprintf(stderr, "%s: seed %u batch %zu strip %d differs from getline\n",
+                                 LineScanner::isaName(isa), seed, batch, strip);
+                    CHECK(false);
+                }
+            }
+            CHECK(LineScanner::countLines(text) == expected.size());
+        }
+    }
+}
+
+void testEdgeCases(LineScanner::Isa isa) {
+    for (const char* text : {"", "\n", "\n\n", "a", "a\n", "\r\n", "a\r\nb\r", "\r\r\n", "no terminator\r"}) {
+        for (bool strip : {false, true}) {
+            if (scannerLines(text, 3, strip) != getlineLines(text, strip)) {
+                std::fprintf(stderr, "%s: edge case differs from getline\n", LineScanner::isaName(isa));
+                CHECK(false);
+            }
+        }
+        CHECK(LineScanner::countLines(text) == getlineLines(text, false).size());
+    }
+}
+
+int main() {
+    const LineScanner::Isa detected = LineScanner::activeIsa();
+    for (auto isa : kAllIsas) {
+        if (!LineScanner::forceIsa(isa)) {
+            std::printf("%s: not supported, skipped\n", LineScanner::isaName(isa));
+            continue;
+        }
+        testKernelsMatchGetline(isa);
+        testEdgeCases(isa);
+    }
+    LineScanner::forceIsa(detected);
+    return testFailures() ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+#include "Check.h"
+#include "../Files/FileReader.h"
+#include "../Files/ParallelFileReader.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef TEST_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr size_t kLines = 5000;
+
+std::string writeLines(const std::string& name) {
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (size_t i = 1; i <= kLines; ++i) out << "line " << i << '\n';
+    return path;
+}
+
+// Small chunks so the work is spread over many tasks
+ParallelFileReader::Options smallChunks() {
+    ParallelFileReader::Options options;
+    options.threads = 4;
+    options.chunkSize = 256;
+    return options;
+}
+
+template <typename F>
+bool throwsRuntimeError(F&& f) {
+    try {
+        f();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+void testForEachLineCallbackThrows(const std::string& path) {
+    ParallelFileReader reader(path, smallChunks());
+    CHECK(throwsRuntimeError([&] {
+        reader.forEachLine([](size_t lineNumber, std::string_view) {
+            if (lineNumber == 1234) throw std::runtime_error("bad line");
+        });
+    }));
+
+    // The reader and its pool are still usable
+    std::atomic<size_t> lines{0};
+    CHECK(reader.forEachLine([&](size_t, std::string_view) { ++lines; }));
+    CHECK(lines == kLines);
+}
+
+void testMapLinesThrows(const std::string& path) {
+    for (auto ordering : {ParallelFileReader::Ordering::Ordered, ParallelFileReader::Ordering::Unordered}) {
+        ParallelFileReader reader(path, smallChunks());
+        CHECK(throwsRuntimeError([&] {
+            reader.mapLines(
+                [](size_t lineNumber, std::string_view line) {
+                    if (lineNumber == 4000) throw std::runtime_error("bad line");
+                    return line.size();
+                },
+                [](size_t, size_t) {}, ordering);
+        }));
+
+        size_t delivered = 0;
+        CHECK(throwsRuntimeError([&] {
+            reader.mapLines([](size_t, std::string_view line) { return line.size(); },
+                            [&](size_t, size_t) {
+                                if (++delivered == 100) throw std::runtime_error("sink full");
+                            },
+                            ordering);
+        }));
+        CHECK(delivered == 100);
+
+        size_t total = 0;
+        CHECK(reader.mapLines([](size_t, std::string_view) { return size_t{1}; },
+                              [&](size_t, size_t one) { total += one; }, ordering));
+        CHECK(total == kLines);
+    }
+}
+
+#ifdef TEST_WITH_ZLIB
+// Chunking a gzip file would split compressed bytes at '\n'; the reader
+// must fall back to FileReader and see the decompressed lines
+void testGzipFallsBackToSerial() {
+    auto path = (std::filesystem::temp_directory_path() / "parallel_file_reader_test.log.gz").string();
+    gzFile out = gzopen(path.c_str(), "wb");
+    for (size_t i = 1; i <= kLines; ++i) {
+        std::string line = "line " + std::to_string(i) + "\n";
+        gzwrite(out, line.data(), static_cast<unsigned>(line.size()));
+    }
+    gzclose(out);
+
+    std::vector<std::string> serial;
+    FileReader(path).forEachLine([&](std::string_view line) { serial.emplace_back(line); });
+    CHECK(serial.size() == kLines);
+
+    std::mutex mutex;
+    std::vector<std::string> parallel(serial.size() + 1);
+    ParallelFileReader reader(path, smallChunks());
+    CHECK(reader.forEachLine([&](size_t lineNumber, std::string_view line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (lineNumber <= serial.size()) parallel[lineNumber - 1] = line;
+    }));
+    parallel.pop_back();
+    CHECK(parallel == serial);
+
+    std::vector<std::string> mapped;
+    CHECK(reader.mapLines([](size_t, std::string_view line) { return std::string(line); },
+                          [&](size_t, std::string&& line) { mapped.push_back(std::move(line)); },
+                          ParallelFileReader::Ordering::Ordered));
+    CHECK(mapped == serial);
+    std::filesystem::remove(path);
+}
+#endif
+
+int main() {
+    std::string path = writeLines("parallel_file_reader_test.log");
+    testForEachLineCallbackThrows(path);
+    testMapLinesThrows(path);
+#ifdef TEST_WITH_ZLIB
+    testGzipFallsBackToSerial();
+#endif
+    std::filesystem::remove(path);
+    return testFailures() ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+#include "Check.h"
+#include "../Format/PatternScanner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using format_security::FlaggedLine;
+using format_security::PatternMatch;
+using format_security::PatternScanner;
+
+namespace {
+
+bool isControl(unsigned char b) {
+    return (b < 0x20 && b != '\t' && b != '\n' && b != '\r') || b == 0x7f;
+}
+
+bool sameByte(char a, char b, bool caseInsensitive) {
+    if (a == b) return true;
+    auto lower = [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c; };
+    return caseInsensitive && lower(a) == lower(b) && ((a | 0x20) >= 'a' && (a | 0x20) <= 'z');
+}
+
+// Every occurrence by trying each pattern at each offset, sorted by
+// (last byte, pattern)
+std::vector<PatternMatch> bruteForce(std::string_view text, const std::vector<std::string>& patterns,
+                                     PatternScanner::Options options) {
+    std::vector<std::pair<size_t, PatternMatch>> found;  // (end, match)
+    for (size_t at = 0; at < text.size(); ++at) {
+        for (uint32_t id = 0; id < patterns.size(); ++id) {
+            const std::string& p = patterns[id];
+            if (at + p.size() > text.size()) continue;
+            bool match = true;
+            for (size_t k = 0; k < p.size() && match; ++k) match = sameByte(text[at + k], p[k], options.caseInsensitive);
+            if (match) found.push_back({at + p.size() - 1, {at, id}});
+        }
+        if (options.controlBytes && isControl(static_cast<unsigned char>(text[at]))) {
+            found.push_back({at, {at, static_cast<uint32_t>(patterns.size())}});
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : a.second.pattern < b.second.pattern;
+    });
+    std::vector<PatternMatch> matches;
+    for (const auto& entry : found) matches.push_back(entry.second);
+    return matches;
+}
+
+std::vector<PatternMatch> sortedByEnd(std::vector<PatternMatch> matches, const std::vector<std::string>& patterns) {
+    auto end = [&](const PatternMatch& m) { return m.offset + (m.pattern < patterns.size() ? patterns[m.pattern].size() : 1); };
+    std::stable_sort(matches.begin(), matches.end(), [&](const PatternMatch& a, const PatternMatch& b) {
+        return end(a) != end(b) ? end(a) < end(b) : a.pattern < b.pattern;
+    });
+    return matches;
+}
+
+bool sameMatches(const std::vector<PatternMatch>& a, const std::vector<PatternMatch>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const PatternMatch& x, const PatternMatch& y) {
+        return x.offset == y.offset && x.pattern == y.pattern;
+    });
+}
+
+// Random text over `alphabet` with the patterns planted often, lengths
+// chosen to exercise whole 64-byte prefilter blocks and the scalar tail
+std::string makeText(std::mt19937& rng, const std::string& alphabet, const std::vector<std::string>& patterns,
+                     size_t length) {
+    std::uniform_int_distribution<size_t> pickByte(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> pickPattern(0, patterns.size() - 1);
+    std::uniform_int_distribution<int> plant(0, 15);
+    std::string text;
+    while (text.size() < length) {
+        if (plant(rng) == 0) text += patterns[pickPattern(rng)];
+        else text += alphabet[pickByte(rng)];
+    }
+    text.resize(length);
+    return text;
+}
+
+void checkAgainstBruteForce(const char* name, const std::vector<std::string>& patterns,
+                            PatternScanner::Options options, const std::string& alphabet) {
+    PatternScanner scanner(patterns, options);
+    std::mt19937 rng(20);
+    for (size_t length : {0u, 1u, 5u, 63u, 64u, 65u, 127u, 200u, 1000u, 4099u}) {
+        for (int round = 0; round < 4; ++round) {
+            std::string text = makeText(rng, alphabet, patterns, length);
+            std::vector<PatternMatch> expected = bruteForce(text, patterns, options);
+            std::vector<PatternMatch> found;
+            CHECK(scanner.findAll(text, found) == found.size());
+
+            bool ok = sameMatches(sortedByEnd(found, patterns), expected);
+            // findAll already reports in order of the last byte
+            auto end = [&](const PatternMatch& m) { return m.offset + (m.pattern < patterns.size() ? patterns[m.pattern].size() : 1); };
+            for (size_t i = 1; i < found.size(); ++i) ok = ok && end(found[i - 1]) <= end(found[i]);
+            ok = ok && scanner.containsAny(text) == !expected.empty();
+            if (!ok) {
+                std::fprintf(stderr, "%s: length %zu round %d: %zu matches, expected %zu\n", name, length, round,
+                             found.size(), expected.size());
+                CHECK(false);
+            }
+
+            // flagLines: one entry per line with matches, counted by the line
+            // each match starts on
+            std::vector<FlaggedLine> flags;
+            scanner.flagLines(text, flags);
+            std::vector<FlaggedLine> lines;
+            for (const PatternMatch& m : expected) {
+                size_t line = static_cast<size_t>(std::count(text.begin(), text.begin() + static_cast<long>(m.offset), '\n'));
+                size_t start = text.rfind('\n', m.offset == 0 ? std::string::npos : m.offset - 1);
+                start = (m.offset == 0 || start == std::string::npos) ? 0 : start + 1;
+                if (!lines.empty() && lines.back().line == line) {
+                    ++lines.back().matches;
+                } else {
+                    lines.push_back({line, start, m.pattern, 1});
+                }
+            }
+            bool linesOk = flags.size() == lines.size();
+            for (size_t i = 0; linesOk && i < flags.size(); ++i) {
+                linesOk = flags[i].line == lines[i].line && flags[i].offset == lines[i].offset &&
+                          flags[i].matches == lines[i].matches;
+            }
+            if (!linesOk) {
+                std::fprintf(stderr, "%s: length %zu round %d: flagLines differs\n", name, length, round);
+                CHECK(false);
+            }
+        }
+    }
+}
+
+} // namespace
+
+// Overlapping patterns and shared suffixes exercise the failure links
+void testOverlappingPatterns() {
+    checkAgainstBruteForce("overlapping", {"he", "she", "his", "hers", "s", "ssh", "aaa", "aa"}, {}, "hesrixa\n ");
+}
+
+void testFormatSpecifiersAndControlBytes() {
+    std::string alphabet = "%nhlsxXp0123 \t\r\n";
+    alphabet += '\x01';
+    alphabet += '\x7f';
+    alphabet += '\x1b';
+    checkAgainstBruteForce("format", PatternScanner::formatSpecifiers(), {}, alphabet);
+    PatternScanner::Options noControl;
+    noControl.controlBytes = false;
+    checkAgainstBruteForce("format without control", PatternScanner::formatSpecifiers(), noControl, alphabet);
+}
+
+void testCaseInsensitive() {
+    PatternScanner::Options options;
+    options.caseInsensitive = true;
+    options.controlBytes = false;
+    checkAgainstBruteForce("case-insensitive", {"ERROR", "warn", "x%Y"}, options, "eErRoOwWaAnNxXyY%\n@[`{");
+}
+
+// First bytes from all 16 high nibbles with 16 different low-nibble sets:
+// more than the 8 prefilter buckets, so sets are folded together
+void testPrefilterBucketFolding() {
+    std::vector<std::string> patterns;
+    std::string alphabet;
+    for (unsigned high = 0; high < 16; ++high) {
+        for (unsigned low = 0; low < 16; ++low) {
+            char b = static_cast<char>(high << 4 | low);
+            alphabet += b;
+            if ((low * 7 + high) % 16 < high % 5 + 1) patterns.push_back(std::string(1, b) + static_cast<char>('A' + high));
+        }
+    }
+    PatternScanner::Options options;
+    options.controlBytes = false;
+    checkAgainstBruteForce("folded buckets", patterns, options, alphabet);
+    checkAgainstBruteForce("folded buckets with control", patterns, {}, alphabet);
+}
+
+void testDescribe() {
+    const PatternScanner& scanner = PatternScanner::defaults();
+    CHECK(scanner.describe(0) == "%n");
+    CHECK(scanner.describe(scanner.controlPattern()) == "control byte");
+    bool threw = false;
+    try {
+        PatternScanner bad({"ok", ""});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+int main() {
+    testOverlappingPatterns();
+    testFormatSpecifiersAndControlBytes();
+    testCaseInsensitive();
+    testPrefilterBucketFolding();
+    testDescribe();
+    std::printf("prefilter %s\n", PatternScanner::defaults().vectorized() ? "vectorized" : "scalar");
+    return testFailures() ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#include "Check.h"
+#include "../Format/SafeFormat.h"
+
+#include <string>
+#include <string_view>
+
+using namespace format_security;
+
+namespace {
+
+// Formats a runtime string with one int argument, the way AsyncLogger
+// replays a stored format
+std::string runtimeFormat(std::string_view format, int value) {
+    const FormatArg args[] = {detail::makeArg(value)};
+    char out[64];
+    size_t needed = detail::vformatTo(out, format, args, 1);
+    return std::string(out, needed < sizeof(out) ? needed : sizeof(out));
+}
+
+} // namespace
+
+void testCheckedFormats() {
+    CHECK(formatString("{} of {}", 3, 10) == "3 of 10");
+    CHECK(formatString("{{{}}}", 7) == "{7}");
+    CHECK(formatString("{:x} {:.2}", 255u, 1.5) == "ff 1.50");
+    auto fixed = formatFixed<8>("{}-{}", 12345, 67890);
+    CHECK(fixed.truncated() && fixed.view() == "12345-67");
+}
+
+// Unchecked text must neither hang nor read past the end of the view
+void testMalformedRuntimeFormats() {
+    CHECK(runtimeFormat("abc{", 1) == "abc{");
+    CHECK(runtimeFormat("{} and {", 1) == "1 and {");
+    CHECK(runtimeFormat("{:x", 1) == "{:x");
+    CHECK(runtimeFormat("a}b", 1) == "a}b");
+    CHECK(runtimeFormat("}", 1) == "}");
+    CHECK(runtimeFormat("{", 1) == "{");
+    CHECK(runtimeFormat("{}{}", 5) == "5");  // Placeholders past the arguments print nothing
+
+    // A view into a larger buffer: the byte after it must not be taken as
+    // the second brace of an escape
+    std::string_view cut = std::string_view("x{{").substr(0, 2);
+    CHECK(runtimeFormat(cut, 9) == "x{");
+}
+
+int main() {
+    testCheckedFormats();
+    testMalformedRuntimeFormats();
+    return testFailures() ? 1 : 0;
+}
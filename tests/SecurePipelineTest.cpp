@@ -0,0 +1,54 @@
+#include "Check.h"
+#include "../Format/SecurePipeline.h"
+
+#include <sstream>
+#include <string>
+
+using format_security::SecurePipeline;
+
+namespace {
+
+std::string runPipeline(const std::string& input, SecurePipeline::Stats& stats) {
+    SecurePipeline pipeline;
+    std::string output;
+    pipeline.setSink([&](std::string_view text) {
+        output += text;
+        return true;
+    });
+    std::istringstream stream(input);
+    pipeline.run(stream);
+    stats = pipeline.stats();
+    return output;
+}
+
+} // namespace
+
+// Content lines are rewritten, never cut to the filename length limit
+void testLongLinesKeptWhole() {
+    std::string longLine(300, 'a');
+    longLine[250] = '%';
+    std::string expected = longLine;
+    expected[250] = '_';
+    std::string plainLong(500, 'b');
+
+    SecurePipeline::Stats stats;
+    std::string output = runPipeline(longLine + '\n' + plainLong + '\n' + "short\n", stats);
+    CHECK(output == "Line 1: " + expected + "\nLine 2: " + plainLong + "\nLine 3: short\n");
+    CHECK(stats.sanitizedLines == 1);
+    CHECK(stats.validate.lines == 3);
+}
+
+// A CRLF terminator leaves '\r' in the line, as getline does; it is
+// replaced and counted
+void testCarriageReturnSanitized() {
+    SecurePipeline::Stats stats;
+    std::string output = runPipeline("dos line\r\nunix line\n", stats);
+    CHECK(output == "Line 1: dos line_\nLine 2: unix line\n");
+    CHECK(stats.sanitizedLines == 1);
+}
+
+int main() {
+    testLongLinesKeptWhole();
+    testCarriageReturnSanitized();
+    return testFailures() ? 1 : 0;
+}
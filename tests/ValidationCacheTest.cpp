@@ -0,0 +1,185 @@
+#include "Check.h"
+#include "../Format/FormatSecurity.h"
+#include "../Format/ValidationCache.h"
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using format_security::FormatDemo;
+using format_security::ValidationCache;
+
+namespace {
+
+// Path-like inputs; some invalid (traversal, control byte), some long
+// enough to be truncated by sanitizing, some rewritten
+std::vector<std::string> makeInputs(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> length(4, 140), kind(0, 9);
+    std::vector<std::string> inputs;
+    for (size_t i = 0; i < count; ++i) {
+        std::string text = "p" + std::to_string(i) + "/";
+        size_t target = static_cast<size_t>(length(rng));
+        while (text.size() < target) text += static_cast<char>('a' + rng() % 26);
+        switch (kind(rng)) {
+            case 0: text += "/../etc"; break;
+            case 1: text[text.size() / 2] = '\x07'; break;
+            case 2: text += "<%n>\r\n"; break;
+            default: break;
+        }
+        inputs.push_back(std::move(text));
+    }
+    return inputs;
+}
+
+bool matchesReference(const ValidationCache::Result& result, const std::string& input) {
+    return result.valid == FormatDemo::isValidFilename(input) &&
+           result.sanitized.view() == FormatDemo::sanitizeInput(input);
+}
+
+size_t smallEntryBytes() {
+    return ValidationCache::entryBytes("hot-0", ptrdemo::SharedString("hot-0"));
+}
+
+} // namespace
+
+void testHitsAndMisses() {
+    ValidationCache cache;
+    const std::string inputs[] = {"report.txt", "../secret", "a%nb", std::string(150, 'x') + "%", ""};
+    for (const std::string& input : inputs) CHECK(matchesReference(cache.lookup(input), input));
+    for (const std::string& input : inputs) CHECK(matchesReference(cache.lookup(input), input));
+    ValidationCache::Stats stats = cache.stats();
+    CHECK(stats.misses == 5);
+    CHECK(stats.hits == 5);
+    CHECK(stats.entries == 5);
+    CHECK(stats.evictions == 0);
+
+    cache.clear();
+    CHECK(cache.stats().entries == 0);
+    CHECK(cache.stats().bytes == 0);
+    CHECK(matchesReference(cache.lookup("report.txt"), "report.txt"));
+    CHECK(cache.stats().misses == 6);
+}
+
+// Results stay exact while entries are evicted and reinserted
+void testDifferentialThroughEvictions() {
+    std::vector<std::string> inputs = makeInputs(3000, 5);
+    ValidationCache cache(ValidationCache::Options{32 * 1024, 4});
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<size_t> hot(0, 99), any(0, inputs.size() - 1);
+    size_t mismatches = 0;
+    for (int i = 0; i < 50000; ++i) {
+        const std::string& input = inputs[i % 3 ? hot(rng) : any(rng)];
+        mismatches += !matchesReference(cache.lookup(input), input);
+        if (i % 1000 == 0) CHECK(cache.stats().bytes <= 32 * 1024);
+    }
+    CHECK(mismatches == 0);
+    ValidationCache::Stats stats = cache.stats();
+    CHECK(stats.evictions > 0);
+    CHECK(stats.hits + stats.misses == 50000);
+}
+
+// CLOCK: entries hit since the hand last passed survive; unreferenced ones
+// are evicted instead. The shard starts full of filler entries, and the hot
+// entries go in one at a time, each evicting a filler, so hot entries sit
+// behind fillers in probe runs and must be shifted back when those go; a
+// hot entry left unreachable would show up as a miss.
+void testClockKeepsReferencedEntries() {
+    constexpr size_t hotCount = 180;
+    ValidationCache cache(ValidationCache::Options{(hotCount + 1) * smallEntryBytes(), 1});
+    for (size_t i = 0; i <= hotCount; ++i) cache.lookup("fill-" + std::to_string(i));
+    std::vector<std::string> hot;
+    size_t expectedHits = 0;
+    for (size_t i = 0; i < hotCount; ++i) {
+        hot.push_back("hot-" + std::to_string(i));
+        for (const std::string& key : hot) cache.lookup(key);
+        expectedHits += hot.size() - 1;
+    }
+    ValidationCache::Stats stats = cache.stats();
+    CHECK(stats.hits == expectedHits);
+    CHECK(stats.evictions == hotCount);  // Every filler but one
+
+    constexpr size_t rounds = 2000;
+    for (size_t round = 0; round < rounds; ++round) {
+        for (const std::string& key : hot) cache.lookup(key);
+        cache.lookup("cold-" + std::to_string(round));
+    }
+    stats = cache.stats();
+    CHECK(stats.hits == expectedHits + hotCount * rounds);
+    CHECK(stats.misses == 2 * hotCount + 1 + rounds);
+    CHECK(stats.evictions == hotCount + rounds);  // The last filler, then each cold entry evicts the previous one
+    CHECK(stats.entries == hotCount + 1);
+    CHECK(stats.bytes == (hotCount + 1) * smallEntryBytes());
+
+    // The latest cold entry is still there, the one before it is gone
+    cache.lookup("cold-" + std::to_string(rounds - 1));
+    CHECK(cache.stats().hits == stats.hits + 1);
+    cache.lookup("cold-" + std::to_string(rounds - 2));
+    CHECK(cache.stats().misses == stats.misses + 1);
+}
+
+// With nothing referenced, every insert into a full shard evicts exactly
+// one entry, in the hand's order
+void testClockEvictsUnreferencedEntries() {
+    constexpr size_t capacity = 64;
+    ValidationCache cache(ValidationCache::Options{capacity * smallEntryBytes(), 1});
+    for (size_t i = 0; i < capacity; ++i) cache.lookup("old-" + std::to_string(i));
+    for (size_t i = 0; i < capacity; ++i) cache.lookup("new-" + std::to_string(i));
+    ValidationCache::Stats stats = cache.stats();
+    CHECK(stats.evictions == capacity);
+    CHECK(stats.entries == capacity);
+    CHECK(stats.bytes == capacity * smallEntryBytes());
+    CHECK(stats.hits == 0);
+}
+
+// Each shard gets maxBytes / shards; an entry bigger than that is returned
+// but not kept
+void testShardBudgets() {
+    ValidationCache cache(ValidationCache::Options{4 * 1024, 3});  // Rounded up to 4 shards
+    std::string large(2000, 'L');
+    CHECK(ValidationCache::entryBytes(large, ptrdemo::SharedString(large)) > 1024);
+    CHECK(matchesReference(cache.lookup(large), large));
+    CHECK(matchesReference(cache.lookup(large), large));
+    CHECK(cache.stats().entries == 0);
+    CHECK(cache.stats().misses == 2);
+
+    for (int i = 0; i < 1000; ++i) cache.lookup("k" + std::to_string(i));
+    ValidationCache::Stats stats = cache.stats();
+    CHECK(stats.bytes <= 4 * 1024);
+    CHECK(stats.entries * smallEntryBytes() == stats.bytes);
+    CHECK(stats.entries + stats.evictions == 1000);
+}
+
+void testConcurrentLookups() {
+    std::vector<std::string> inputs = makeInputs(2000, 9);
+    ValidationCache cache(ValidationCache::Options{48 * 1024, 4});
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937 rng(t);
+            std::uniform_int_distribution<size_t> pick(0, inputs.size() - 1);
+            for (int i = 0; i < 20000; ++i) {
+                const std::string& input = inputs[pick(rng) % (i % 2 ? 50 : inputs.size())];
+                if (!matchesReference(cache.lookup(input), input)) mismatches.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    CHECK(mismatches.load() == 0);
+    ValidationCache::Stats stats = cache.stats();
+    CHECK(stats.hits + stats.misses == 4 * 20000);
+    CHECK(stats.bytes <= 48 * 1024);
+}
+
+int main() {
+    testHitsAndMisses();
+    testDifferentialThroughEvictions();
+    testClockKeepsReferencedEntries();
+    testClockEvictsUnreferencedEntries();
+    testShardBudgets();
+    testConcurrentLookups();
+    return testFailures() ? 1 : 0;
+}
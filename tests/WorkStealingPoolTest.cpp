@@ -0,0 +1,62 @@
+#include "Check.h"
+#include "../Concurrency/WorkStealingPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// A throwing task still finishes: wait() returns, rethrows the first
+// exception once, and the pool keeps working afterwards
+void testThrowingTaskRethrownFromWait() {
+    WorkStealingPool pool(4);
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&ran, i] {
+            ++ran;
+            if (i % 10 == 3) throw std::runtime_error("task " + std::to_string(i));
+        });
+    }
+    bool caught = false;
+    try {
+        pool.wait();
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()).rfind("task ", 0) == 0;
+    }
+    CHECK(caught);
+    CHECK(ran == 100);
+
+    pool.wait();  // Already reported: must not throw again
+    pool.submit([&ran] { ++ran; });
+    pool.wait();
+    CHECK(ran == 101);
+}
+
+void testThrowingTaskViaTryRunPending() {
+    WorkStealingPool pool(1);
+    std::atomic<bool> started{false}, release{false};
+    // Occupy the only worker before queueing the throwing task, so it can
+    // only run through tryRunPending
+    pool.submit([&] {
+        started = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!started) std::this_thread::yield();
+    pool.submit([] { throw std::logic_error("helped"); });
+    bool helped = pool.tryRunPending();
+    release = true;
+    CHECK(helped);
+    bool caught = false;
+    try {
+        pool.wait();
+    } catch (const std::logic_error&) {
+        caught = true;
+    }
+    CHECK(caught);
+}
+
+int main() {
+    testThrowingTaskRethrownFromWait();
+    testThrowingTaskViaTryRunPending();
+    return testFailures() ? 1 : 0;
+}